@@ -0,0 +1,241 @@
+// per call latency and throughput of logger::log, logger::c_log and wlogger::log
+// every configuration runs with 1, 2, 4 ... up to the given number of producer threads, each making the same number of calls,
+// every call is timed on its own into a per-thread log-linear histogram, the histograms are merged once the threads are done
+// one result per line, logfmt by default or JSON with --json, the latencies are in nanoseconds and include the cost of reading the clock,
+// which is printed first as timer_ns
+//
+// configurations: api (log, c_log, wlog) x mode (sync, async) x level (enabled, disabled) x sink (null, file, uring, compressed)
+// a disabled level never reaches the sink, so it only runs against the null sink
+//
+// build from the repository root:
+//   g++ -std=c++20 -O2 -Isrc bench/logging.cpp src/*.cpp -lbacktrace -ldl -pthread -o logging_bench
+// run:
+//   ./logging_bench [--calls 200000] [--threads 4] [--dir /tmp] [--apis log,c_log,wlog] [--sinks null,file,uring,compressed] [--json]
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AustinUtils.hpp"
+
+using namespace AustinUtils;
+
+using bench_clock = std::chrono::steady_clock;
+
+/*
+ * counts values in buckets of 1/32 of their power of two, so every percentile is within about 3% of the real value
+ * values below 64 get exact buckets
+ */
+struct histogram {
+    static constexpr u32 sub_bits = 5;
+    static constexpr u32 sub_count = 1 << sub_bits;
+    std::vector<u64> counts = std::vector<u64>(64 * sub_count, 0);
+    u64 total = 0;
+    u64 max = 0;
+
+    static usize bucket(const u64 v) {
+        const u32 magnitude = std::bit_width(v);
+        if (magnitude <= sub_bits + 1) return v;
+        const u32 shift = magnitude - sub_bits - 1;
+        return (shift + 1) * sub_count + (v >> shift) - sub_count;
+    }
+
+    //the largest value that lands in bucket b
+    static u64 upper(const usize b) {
+        if (b < 2 * sub_count) return b;
+        const u32 shift = cast(b / sub_count - 1, u32);
+        return ((b % sub_count + sub_count + 1) << shift) - 1;
+    }
+
+    void record(const u64 v) {
+        counts[bucket(v)]++;
+        total++;
+        max = std::max(max, v);
+    }
+
+    void merge(const histogram& other) {
+        for (usize i = 0; i < counts.size(); i++) counts[i] += other.counts[i];
+        total += other.total;
+        max = std::max(max, other.max);
+    }
+
+    NODISCARD u64 percentile(const double p) const {
+        const u64 rank = std::max<u64>(1, cast(p / 100 * cast(total, double) + 0.5, u64));
+        u64 seen = 0;
+        for (usize i = 0; i < counts.size(); i++) {
+            seen += counts[i];
+            if (seen >= rank) return std::min(upper(i), max);
+        }
+        return max;
+    }
+};
+
+struct options {
+    usize calls = 200000;
+    usize threads = 4;
+    std::string dir = "/tmp";
+    std::vector<std::string> apis = {"log", "c_log", "wlog"};
+    std::vector<std::string> sinks = {"null", "file", "uring", "compressed"};
+    bool json = false;
+};
+
+struct result {
+    histogram latency;
+    double seconds = 0;
+};
+
+static std::vector<std::string> splitList(const std::string& s) {
+    std::vector<std::string> out;
+    usize start = 0;
+    loop {
+        const usize end = s.find(',', start);
+        out.push_back(s.substr(start, end - start));
+        if (end == std::string::npos) return out;
+        start = end + 1;
+    }
+}
+
+static bool contains(const std::vector<std::string>& list, const std::string& s) {
+    return std::find(list.begin(), list.end(), s) != list.end();
+}
+
+static std::shared_ptr<log_sink> makeSink(const std::string& sink, const std::string& path) {
+    if (sink == "file") return std::make_shared<file_sink>(path);
+    if (sink == "uring") return std::make_shared<uring_sink>(path);
+    if (sink == "compressed") return std::make_shared<compressed_sink>(std::make_shared<file_sink>(path));
+    return std::make_shared<null_sink>();
+}
+
+//runs call(thread, i) calls times on each of threads threads, all starting together, timing every call
+static result run(const usize threads, const usize calls, const std::function<void(usize, usize)>& call, const std::function<void()>& finish) {
+    std::vector<histogram> latencies(threads);
+    std::atomic<usize> ready = 0;
+    std::atomic<bool> go = false;
+    std::vector<std::thread> workers;
+    for (usize t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            histogram& h = latencies[t];
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (usize i = 0; i < calls; i++) {
+                const auto before = bench_clock::now();
+                call(t, i);
+                h.record(cast(std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - before).count(), u64));
+            }
+        });
+    }
+    while (ready.load() != threads) std::this_thread::yield();
+    const auto start = bench_clock::now();
+    go.store(true, std::memory_order_release);
+    for (std::thread& w : workers) w.join();
+    //async lines are only done once they reach the sink
+    finish();
+
+    result r;
+    r.seconds = std::chrono::duration<double>(bench_clock::now() - start).count();
+    for (const histogram& h : latencies) r.latency.merge(h);
+    return r;
+}
+
+static void report(const options& opts, const char* api, const char* mode, const char* level, const std::string& sink, const usize threads,
+                   const result& r) {
+    const double total = cast(r.latency.total, double);
+    const u64 p50 = r.latency.percentile(50), p99 = r.latency.percentile(99), p999 = r.latency.percentile(99.9);
+    if (opts.json) {
+        std::printf("{\"api\":\"%s\",\"mode\":\"%s\",\"level\":\"%s\",\"sink\":\"%s\",\"threads\":%zu,\"calls\":%.0f,\"seconds\":%.4f,"
+                    "\"calls_per_sec\":%.0f,\"p50_ns\":%llu,\"p99_ns\":%llu,\"p999_ns\":%llu,\"max_ns\":%llu}\n",
+                    api, mode, level, sink.c_str(), threads, total, r.seconds, total / r.seconds, cast(p50, unsigned long long),
+                    cast(p99, unsigned long long), cast(p999, unsigned long long), cast(r.latency.max, unsigned long long));
+    } else {
+        std::printf("api=%s mode=%s level=%s sink=%s threads=%zu calls=%.0f seconds=%.4f calls_per_sec=%.0f p50_ns=%llu p99_ns=%llu "
+                    "p999_ns=%llu max_ns=%llu\n",
+                    api, mode, level, sink.c_str(), threads, total, r.seconds, total / r.seconds, cast(p50, unsigned long long),
+                    cast(p99, unsigned long long), cast(p999, unsigned long long), cast(r.latency.max, unsigned long long));
+    }
+    std::fflush(stdout);
+}
+
+//the cheapest a timed call can be, two clock reads around nothing
+static u64 timerOverhead() {
+    histogram h;
+    for (usize i = 0; i < 100000; i++) {
+        const auto before = bench_clock::now();
+        h.record(cast(std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - before).count(), u64));
+    }
+    return h.percentile(50);
+}
+
+static void runLogger(const options& opts, const std::string& api, const bool async, const bool enabled, const std::string& sink, const usize threads) {
+    const std::string path = opts.dir + "/austinutils_bench_" + sink + ".log";
+    std::remove(path.c_str());
+    result r;
+    {
+        logger lg("bench");
+        wlogger wlg(L"bench");
+        logger_base& used = api == "wlog" ? static_cast<logger_base&>(wlg) : lg;
+        used.set_sink(makeSink(sink, path));
+        used.set_level(enabled ? LOG_INFO : LOG_WARN);
+        if (async) used.set_async();
+        std::function<void(usize, usize)> call;
+        if (api == "log") {
+            call = [&](const usize t, const usize i) {
+                lg.log(LOG_INFO, "request ", i, " from worker ", t, " served in ", 0.25 * cast(i % 100, double), " ms");
+            };
+        } else if (api == "c_log") {
+            call = [&](const usize t, const usize i) {
+                lg.c_log(LOG_INFO, "request %zu from worker %zu served in %g ms", i, t, 0.25 * cast(i % 100, double));
+            };
+        } else {
+            call = [&](const usize t, const usize i) {
+                wlg.log(LOG_INFO, L"request ", i, L" from worker ", t, L" served in ", 0.25 * cast(i % 100, double), L" ms");
+            };
+        }
+        r = run(threads, opts.calls, call, [&] { used.flush(); });
+    }
+    std::remove(path.c_str());
+    report(opts, api.c_str(), async ? "async" : "sync", enabled ? "enabled" : "disabled", sink, threads, r);
+}
+
+int main(const int argc, char** argv) {
+    options opts;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "--json") opts.json = true;
+        else if (arg == "--calls" && has_value) opts.calls = std::strtoull(argv[++i], null, 10);
+        else if (arg == "--threads" && has_value) opts.threads = std::max<usize>(1, std::strtoull(argv[++i], null, 10));
+        else if (arg == "--dir" && has_value) opts.dir = argv[++i];
+        else if (arg == "--apis" && has_value) opts.apis = splitList(argv[++i]);
+        else if (arg == "--sinks" && has_value) opts.sinks = splitList(argv[++i]);
+        else {
+            std::fprintf(stderr, "usage: %s [--calls n] [--threads n] [--dir path] [--apis log,c_log,wlog] [--sinks null,file,uring,compressed] [--json]\n",
+                         argv[0]);
+            return 1;
+        }
+    }
+
+    const u64 timer = timerOverhead();
+    if (opts.json) std::printf("{\"timer_ns\":%llu}\n", cast(timer, unsigned long long));
+    else std::printf("timer_ns=%llu\n", cast(timer, unsigned long long));
+
+    std::vector<usize> thread_counts;
+    for (usize t = 1; t < opts.threads; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(opts.threads);
+
+    for (const std::string& api : {std::string("log"), std::string("c_log"), std::string("wlog")}) {
+        if (!contains(opts.apis, api)) continue;
+        for (const usize threads : thread_counts) {
+            //a disabled level returns before touching the sink, so the null sink stands in for all of them
+            if (contains(opts.sinks, "null")) runLogger(opts, api, false, false, "null", threads);
+            for (const std::string& sink : opts.sinks) {
+                for (const bool async : {false, true}) runLogger(opts, api, async, true, sink, threads);
+            }
+        }
+    }
+}
@@ -0,0 +1,89 @@
+// file_sink against uring_sink (through io_uring and through the pwritev fallback), sync and async
+// every configuration writes the same lines from the same number of threads into a fresh file and prints one logfmt line
+//
+// build from the repository root:
+//   g++ -std=c++20 -O2 -Isrc bench/uring_sink.cpp src/*.cpp -lbacktrace -ldl -pthread -o uring_sink_bench
+// run:
+//   ./uring_sink_bench [lines per thread = 1000000] [threads = 4] [directory = /tmp]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AustinUtils.hpp"
+
+using namespace AustinUtils;
+
+struct result {
+    double seconds;
+    u64 bytes;
+};
+
+static result run(const std::shared_ptr<log_sink>& sink, const bool async, const usize lines, const usize threads, const std::string& file) {
+    logger lg("bench");
+    lg.set_sink(sink);
+    if (async) lg.set_async();
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (usize t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            for (usize i = 0; i < lines; i++) lg.info("request ", i, " from worker ", t, " served in ", 0.25 * cast(i % 100, double), " ms");
+        });
+    }
+    for (std::thread& w : workers) w.join();
+    lg.flush();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::FILE* f = std::fopen(file.c_str(), "rb");
+    u64 bytes = 0;
+    if (f != null) {
+        std::fseek(f, 0, SEEK_END);
+        bytes = cast(std::ftell(f), u64);
+        std::fclose(f);
+    }
+    return {seconds, bytes};
+}
+
+int main(const int argc, char** argv) {
+    const usize lines = argc > 1 ? std::strtoull(argv[1], null, 10) : 1000000;
+    const usize threads = argc > 2 ? std::strtoull(argv[2], null, 10) : 4;
+    const std::string dir = argc > 3 ? argv[3] : "/tmp";
+
+    struct config {
+        const char* name;
+        std::function<std::shared_ptr<log_sink>(const std::string&)> make;
+    };
+    const config sinks[] = {
+        {"file_sink", [](const std::string& path) { return std::make_shared<file_sink>(path); }},
+        {"uring_sink", [](const std::string& path) {
+            auto sink = std::make_shared<uring_sink>(path);
+            if (!sink->using_uring()) std::fprintf(stderr, "io_uring is not available, uring_sink is using pwritev\n");
+            return sink;
+        }},
+        {"uring_sink_pwritev", [](const std::string& path) {
+            uring_sink_options options;
+            options.use_uring = false;
+            return std::make_shared<uring_sink>(path, options);
+        }},
+    };
+
+    for (const bool async : {false, true}) {
+        for (const config& c : sinks) {
+            const std::string path = dir + "/austinutils_bench_" + c.name + ".log";
+            std::remove(path.c_str());
+            result r;
+            {
+                const std::shared_ptr<log_sink> sink = c.make(path);
+                r = run(sink, async, lines, threads, path);
+            }
+            std::remove(path.c_str());
+            const double total = cast(lines * threads, double);
+            std::printf("sink=%s mode=%s threads=%zu lines=%.0f seconds=%.3f lines_per_sec=%.0f mb_per_sec=%.1f\n", c.name,
+                        async ? "async" : "sync", threads, total, r.seconds, total / r.seconds, cast(r.bytes, double) / r.seconds / 1e6);
+        }
+    }
+}
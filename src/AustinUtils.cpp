@@ -1,8 +1,8 @@
-#include "AustinUtils.hpp"
-
-
-
-AUSTINUTILS const AustinUtils::str AustinUtils::AustinUtilsVersion() {
-    return "4.0.1";
-}
-
+#include "AustinUtils.hpp"
+
+
+
+AUSTINUTILS const AustinUtils::str AustinUtils::AustinUtilsVersion() {
+    return "4.0.1";
+}
+
@@ -1,29 +1,50 @@
-#ifndef AUSTIN_UTILS_HPP
-#define AUSTIN_UTILS_HPP
-
-
-
-#include <string>
-#define AUSTINUTILS __declspec(dllexport)
-#include <cstdint>
-
-
-//library files
-
-#include "math.hpp"
-#include "misc.hpp"
-#include "Error.hpp"
-#include "logging.hpp"
-#include "str.hpp"
-#include "linkedlist.hpp"
-
-
-namespace AustinUtils {
-    extern AUSTINUTILS const str AustinUtilsVersion();
-}
-
-
-
-
-
+#ifndef AUSTIN_UTILS_HPP
+#define AUSTIN_UTILS_HPP
+
+
+
+#include <string>
+#define AUSTINUTILS __declspec(dllexport)
+#include <cstdint>
+
+
+//library files
+
+#include "math.hpp"
+#include "misc.hpp"
+#include "Error.hpp"
+#include "logging.hpp"
+#include "asynclog.hpp"
+#include "logsink.hpp"
+#include "uringsink.hpp"
+#include "compressedsink.hpp"
+#include "logformat.hpp"
+#include "loglimit.hpp"
+#include "logkv.hpp"
+#include "flightrecorder.hpp"
+#include "logregistry.hpp"
+#include "metrics.hpp"
+#include "trace.hpp"
+#include "str.hpp"
+#include "strstats.hpp"
+#include "linkedlist.hpp"
+#include "json.hpp"
+#include "encoding.hpp"
+#include "fuzzy.hpp"
+#include "inplacestr.hpp"
+#include "threadpool.hpp"
+#include "parallelstr.hpp"
+#include "strcompress.hpp"
+#include "lzcompress.hpp"
+#include "strcolumn.hpp"
+
+
+namespace AustinUtils {
+    extern AUSTINUTILS const str AustinUtilsVersion();
+}
+
+
+
+
+
 #endif
\ No newline at end of file
@@ -1,21 +1,39 @@
-#include "Error.hpp"
-
-namespace AustinUtils {
-    //Error
-    Error::Error(const str &msg)  noexcept : runtime_error(msg.data()) {
-        trace = boost::stacktrace::stacktrace();
-        std::stringstream fmt;
-        fmt << runtime_error::what() << "\n" << trace << "\n";
-        s = fmt.str();
-    }
-
-    const char *Error::what() const noexcept {
-        std::stringstream fmt;
-        fmt << runtime_error::what() << "\n" << trace << "\n";
-        s = fmt.str();
-
-        return s.c_str();
-    }
-
-
+#include "Error.hpp"
+
+#include <atomic>
+
+namespace AustinUtils {
+    static std::atomic<ErrorHook> error_hook = null;
+
+    void SetErrorHook(const ErrorHook hook) {
+        error_hook.store(hook);
+    }
+
+    //Error
+    Error::Error(const str &msg)  noexcept : runtime_error(msg.data()) {
+        trace = boost::stacktrace::stacktrace();
+        std::stringstream fmt;
+        fmt << runtime_error::what() << "\n" << trace << "\n";
+        s = fmt.str();
+
+        //an Error thrown from inside the hook does not call it again
+        static thread_local bool in_hook = false;
+        if (const ErrorHook hook = error_hook.load(std::memory_order_relaxed); hook != null && !in_hook) {
+            in_hook = true;
+            try {
+                hook(*this);
+            } catch (...) {}
+            in_hook = false;
+        }
+    }
+
+    const char *Error::what() const noexcept {
+        std::stringstream fmt;
+        fmt << runtime_error::what() << "\n" << trace << "\n";
+        s = fmt.str();
+
+        return s.c_str();
+    }
+
+
 }
\ No newline at end of file
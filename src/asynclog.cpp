@@ -0,0 +1,411 @@
+#include "asynclog.hpp"
+
+#include <bit>
+#include <vector>
+
+#include "logging.hpp"
+#include "logsink.hpp"
+
+
+namespace AustinUtils {
+
+    //a batch is handed to the sinks once it gets this big, even if more lines are waiting
+    static constexpr usize batch_bytes = 1 << 16;
+
+    //how often a sleeping writer looks at the queue on its own, backing off while nothing arrives
+    static constexpr auto writer_poll = std::chrono::milliseconds(1);
+    static constexpr auto writer_idle_poll = std::chrono::milliseconds(64);
+
+    async_log_queue::async_log_queue(const usize capacity, const LOG_OVERFLOW overflow) : overflow(overflow) {
+        const usize n = std::bit_ceil(std::max<usize>(capacity, 2));
+        slots = std::make_unique<slot[]>(n);
+        mask = n - 1;
+        wake_fill = std::clamp<usize>(n / 4, 1, 256);
+        for (usize i = 0; i < n; i++) slots[i].sequence.store(i, std::memory_order_relaxed);
+        writer = std::thread(&async_log_queue::run, this);
+    }
+
+    async_log_queue::~async_log_queue() {
+        stopping.store(true);
+        {
+            std::lock_guard guard(lock);
+            wake.notify_one();
+        }
+        writer.join();
+    }
+
+    usize async_log_queue::capacity() const {
+        return mask + 1;
+    }
+
+    u64 async_log_queue::dropped() const {
+        return drop_count.load(std::memory_order_relaxed);
+    }
+
+    void async_log_queue::wakeWriter(const u64 pos, const bool urgent) {
+        /*
+         * a sleeping writer polls the queue on its own, so a producer only pays for the lock and the futex
+         * when the queue is filling up faster than that or the line should not wait
+         */
+        if (!sleeping.load()) return;
+        if (!urgent && pos + 1 - asleep_at.load(std::memory_order_relaxed) < wake_fill) return;
+        std::lock_guard guard(lock);
+        wake.notify_one();
+    }
+
+    bool async_log_queue::push(log_sink* sink, const LOG_TYPE type, const std::string_view line) {
+        u64 pos = head.load(std::memory_order_relaxed);
+        slot* s;
+        loop {
+            s = &slots[pos & mask];
+            const u64 sequence = s->sequence.load(std::memory_order_acquire);
+            const i64 diff = cast(sequence - pos, i64);
+            if (diff == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                //full
+                if (overflow != LOG_OVERFLOW_BLOCK) {
+                    drop_count.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                wakeWriter(pos, true);
+                std::this_thread::yield();
+                pos = head.load(std::memory_order_relaxed);
+            } else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+
+        s->sink = sink;
+        s->type = type;
+        s->line.assign(line);
+        s->sequence.store(pos + 1);
+        wakeWriter(pos, LogSeverity(type) >= LogSeverity(LOG_ERROR));
+        return true;
+    }
+
+    void async_log_queue::flush() {
+        const u64 target = head.load();
+        std::unique_lock guard(lock);
+        flushing.fetch_add(1);
+        wake.notify_one();
+        drained.wait(guard, [&] { return written.load() >= target; });
+        flushing.fetch_sub(1);
+    }
+
+    void async_log_queue::run() {
+        /*
+         * consecutive lines for the same sink and level go out in one write, every sink used is submitted once per batch
+         * and flushed once the queue runs dry or someone is waiting in flush()
+         */
+        std::string batch;
+        log_sink* batch_sink = null;
+        LOG_TYPE batch_type = LOG_INFO;
+        std::vector<log_sink*> touched;
+        std::vector<log_sink*> unflushed;
+        u64 tail = 0;
+        u64 reported_drops = 0;
+        std::chrono::milliseconds poll = writer_poll;
+
+        const auto emit = [&] {
+            if (batch.empty()) return;
+            batch_sink->write(batch_type, batch);
+            if (std::find(touched.begin(), touched.end(), batch_sink) == touched.end()) touched.push_back(batch_sink);
+            batch.clear();
+        };
+
+        loop {
+            //take every published line, the slot is handed back as soon as its line is copied out
+            usize taken = 0;
+            while (taken < batch_bytes) {
+                slot& s = slots[tail & mask];
+                if (s.sequence.load(std::memory_order_acquire) != tail + 1) break;
+                if (s.sink != batch_sink || s.type != batch_type) {
+                    emit();
+                    batch_sink = s.sink;
+                    batch_type = s.type;
+                }
+                batch.append(s.line);
+                taken += s.line.size();
+                s.sequence.store(tail + mask + 1, std::memory_order_release);
+                tail++;
+            }
+            emit();
+
+            if (overflow == LOG_OVERFLOW_COUNT) {
+                if (const u64 drops = drop_count.load(std::memory_order_relaxed); drops != reported_drops) {
+                    batch_sink = console_sink::global().get();
+                    batch_type = LOG_WARN;
+                    batch.append("[WARN][log]: dropped ").append(std::to_string(drops - reported_drops)).append(" records, the queue was full\n");
+                    emit();
+                    reported_drops = drops;
+                }
+            }
+
+            const bool busy = !touched.empty();
+            for (log_sink* sink : touched) {
+                sink->submit();
+                if (std::find(unflushed.begin(), unflushed.end(), sink) == unflushed.end()) unflushed.push_back(sink);
+            }
+            touched.clear();
+            //only what has been flushed counts as written
+            if (busy && flushing.load() == 0) continue;
+
+            for (log_sink* sink : unflushed) sink->flush();
+            unflushed.clear();
+            written.store(tail);
+            if (flushing.load() != 0) {
+                std::lock_guard guard(lock);
+                drained.notify_all();
+            }
+            if (busy) {
+                poll = writer_poll;
+                continue;
+            }
+            if (stopping.load() && head.load() == tail) return;
+
+            std::unique_lock guard(lock);
+            asleep_at.store(tail, std::memory_order_relaxed);
+            sleeping.store(true);
+            if (slots[tail & mask].sequence.load() != tail + 1 && !stopping.load() && flushing.load() == 0) {
+                //producers only wake it for a filling queue or an urgent line, everything else is picked up by polling
+                wake.wait_for(guard, poll);
+                poll = std::min(poll * 2, writer_idle_poll);
+            }
+            sleeping.store(false);
+        }
+    }
+
+    async_log_queue& async_log_queue::global() {
+        static async_log_queue queue;
+        return queue;
+    }
+
+
+    //every thread that logs deferred records gets one of these, records never straddle the end of the ring
+    static constexpr usize deferred_buffer_bytes = 1 << 20;
+
+    struct deferred_header {
+        logger_base* owner;
+        const deferred_site* site;//null marks padding up to the end of the ring
+        //the owner's LOG_FIELDs and their values at the call
+        u64 time;
+        u64 thread;
+        u32 fields;
+        u32 size;
+        LOG_TYPE type;
+        LOG_ENCODING encoding;
+    };
+
+
+    struct deferred_buffer {
+        std::unique_ptr<u8[]> data = std::make_unique<u8[]>(deferred_buffer_bytes);
+        alignas(64) std::atomic<u64> head = 0;
+        alignas(64) std::atomic<u64> tail = 0;
+        std::atomic<bool> retired = false;
+    };
+
+    static std::atomic<bool> deferred_started = false;
+
+    //polls every thread's buffer, formats the records and writes them through their logger
+    class deferred_writer {
+        std::mutex lock;
+        std::condition_variable wake;
+        std::condition_variable drained;
+        std::vector<std::shared_ptr<deferred_buffer>> buffers;
+        u64 requested = 0;
+        u64 completed = 0;
+        bool stopping = false;
+        std::thread thread;
+
+        //drains one buffer, returns true if there was anything in it
+        static bool drain(deferred_buffer& buffer, std::string& line) {
+            u64 tail = buffer.tail.load(std::memory_order_relaxed);
+            const u64 head = buffer.head.load(std::memory_order_acquire);
+            if (tail == head) return false;
+            while (tail != head) {
+                const usize offset = tail & (deferred_buffer_bytes - 1);
+                if (deferred_buffer_bytes - offset < sizeof(deferred_header)) {
+                    tail += deferred_buffer_bytes - offset;
+                    continue;
+                }
+                deferred_header header;
+                std::memcpy(&header, buffer.data.get() + offset, sizeof(header));
+                if (header.site != null) {
+                    line.clear();
+                    build(line, header, buffer.data.get() + offset + sizeof(header));
+                    header.owner->write(header.type, line);
+                }
+                tail += header.size;
+            }
+            buffer.tail.store(tail, std::memory_order_release);
+            return true;
+        }
+
+        void run() {
+            std::string line;
+            std::vector<std::shared_ptr<deferred_buffer>> pass;
+            loop {
+                u64 request;
+                bool stop;
+                {
+                    std::lock_guard guard(lock);
+                    request = requested;
+                    stop = stopping;
+                    //buffers of exited threads go once they are empty
+                    std::erase_if(buffers, [](const std::shared_ptr<deferred_buffer>& b) {
+                        return b->retired.load() && b->tail.load(std::memory_order_relaxed) == b->head.load(std::memory_order_acquire);
+                    });
+                    pass = buffers;
+                }
+
+                bool any = false;
+                for (const std::shared_ptr<deferred_buffer>& b : pass) any |= drain(*b, line);
+                pass.clear();
+
+                std::unique_lock guard(lock);
+                if (request != completed) {
+                    completed = request;
+                    drained.notify_all();
+                }
+                if (stop && !any) return;
+                //producers never wake the writer, that would cost them a lock, so it polls while there is nothing to do
+                if (!any) wake.wait_for(guard, std::chrono::milliseconds(5), [&] { return stopping || requested != completed; });
+            }
+        }
+
+    public:
+
+        //turns a record into its line, like logger::log but with the fields captured at the call
+        static void build(std::string& line, const deferred_header& header, const u8* args) {
+            const LOG_ENCODING encoding = header.encoding;
+            log_open_record(line, encoding);
+            if (header.fields != LOG_FIELD_NONE) log_append_fields(line, header.fields, header.time, header.thread, encoding);
+            line.append(header.owner->prefixes[encoding][header.type]);
+            if (encoding == LOG_ENCODING_TEXT) {
+                header.site->decode(line, header.site->format, args);
+                line.push_back('\n');
+                return;
+            }
+            log_line text;
+            header.site->decode(text.get(), header.site->format, args);
+            log_open_message(line, encoding);
+            log_append_escaped(line, encoding, text.get());
+            log_close_message(line, encoding);
+            log_close_record(line, encoding);
+        }
+
+        deferred_writer() : thread(&deferred_writer::run, this) {
+            deferred_started.store(true);
+        }
+
+        ~deferred_writer() {
+            {
+                std::lock_guard guard(lock);
+                stopping = true;
+                wake.notify_one();
+            }
+            thread.join();
+            deferred_started.store(false);
+        }
+
+        void add(std::shared_ptr<deferred_buffer> buffer) {
+            std::lock_guard guard(lock);
+            buffers.push_back(std::move(buffer));
+        }
+
+        void flush() {
+            std::unique_lock guard(lock);
+            const u64 request = ++requested;
+            wake.notify_one();
+            drained.wait(guard, [&] { return completed >= request || stopping; });
+        }
+
+        static deferred_writer& global() {
+            static deferred_writer writer;
+            return writer;
+        }
+    };
+
+    //owned by the thread, the writer keeps the buffer alive until it has drained it
+    struct deferred_thread {
+        std::shared_ptr<deferred_buffer> buffer;
+        u64 pending = 0;
+        //records too big for the ring are built here and written on the spot
+        std::vector<u8> oversized;
+        bool is_oversized = false;
+
+        deferred_buffer& get() {
+            if (buffer == null) {
+                buffer = std::make_shared<deferred_buffer>();
+                deferred_writer::global().add(buffer);
+            }
+            return *buffer;
+        }
+
+        ~deferred_thread() {
+            if (buffer != null) buffer->retired.store(true);
+        }
+    };
+
+    static thread_local deferred_thread deferred_local;
+
+    u8* deferred_begin(logger_base* owner, const deferred_site* site, const LOG_TYPE type, const usize args) {
+        const usize size = (sizeof(deferred_header) + args + 7) & ~cast(7, usize);
+        const u32 fields = owner->fields();
+        const deferred_header header = {owner, site, fields & LOG_FIELD_TIME ? log_clock_now() : 0,
+                                        fields & LOG_FIELD_THREAD ? log_thread_id() : 0, fields, cast(size, u32), type, owner->encoding()};
+
+        if (size > deferred_buffer_bytes / 4) {
+            deferred_local.oversized.resize(size);
+            std::memcpy(deferred_local.oversized.data(), &header, sizeof(header));
+            deferred_local.is_oversized = true;
+            return deferred_local.oversized.data() + sizeof(header);
+        }
+
+        deferred_buffer& buffer = deferred_local.get();
+        u64 head = buffer.head.load(std::memory_order_relaxed);
+        const usize offset = head & (deferred_buffer_bytes - 1);
+        const usize to_end = deferred_buffer_bytes - offset;
+        const usize padding = to_end < size ? to_end : 0;
+
+        //full, wait for the writer
+        while (deferred_buffer_bytes - (head - buffer.tail.load(std::memory_order_acquire)) < padding + size) {
+            std::this_thread::yield();
+        }
+
+        if (padding >= sizeof(deferred_header)) {
+            const deferred_header pad = {null, null, 0, 0, LOG_FIELD_NONE, cast(padding, u32), type, LOG_ENCODING_TEXT};
+            std::memcpy(buffer.data.get() + offset, &pad, sizeof(pad));
+        }
+        head += padding;
+        u8* record = buffer.data.get() + (head & (deferred_buffer_bytes - 1));
+        std::memcpy(record, &header, sizeof(header));
+        deferred_local.pending = head + size;
+        return record + sizeof(header);
+    }
+
+    void deferred_commit() {
+        if (deferred_local.is_oversized) {
+            deferred_local.is_oversized = false;
+            //everything this thread deferred before has to come out first
+            deferred_flush();
+            deferred_header header;
+            std::memcpy(&header, deferred_local.oversized.data(), sizeof(header));
+            log_line buffer;
+            std::string& line = buffer.get();
+            deferred_writer::build(line, header, deferred_local.oversized.data() + sizeof(header));
+            header.owner->write(header.type, line);
+            return;
+        }
+        deferred_local.buffer->head.store(deferred_local.pending, std::memory_order_release);
+    }
+
+    void deferred_flush() {
+        if (deferred_started.load()) deferred_writer::global().flush();
+    }
+
+    bool deferred_active() {
+        return deferred_started.load();
+    }
+}
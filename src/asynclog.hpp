@@ -0,0 +1,197 @@
+#ifndef ASYNCLOG_HPP
+#define ASYNCLOG_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include "misc.hpp"
+#include "logformat.hpp"
+
+#define AUSTINUTILS __declspec(dllexport)
+
+namespace AustinUtils {
+
+    enum LOG_TYPE : int;
+    class logger_base;
+    class log_sink;
+
+    //what a producer does when the queue is full
+    enum LOG_OVERFLOW {
+        LOG_OVERFLOW_BLOCK,//wait for the writer to make room
+        LOG_OVERFLOW_DROP,//drop the record
+        LOG_OVERFLOW_COUNT//drop the record, the writer reports how many were dropped
+    };
+
+    /*
+     * a bounded lock-free queue of finished log lines, any number of threads push and one background thread writes them
+     * the writer drains everything available and hands each sink its lines in as few calls as possible, then flushes it
+     * the slots keep their buffers, once they have grown to the usual line length pushing never allocates
+     */
+    class AUSTINUTILS async_log_queue {
+        struct slot {
+            std::atomic<u64> sequence;
+            log_sink* sink;
+            LOG_TYPE type;
+            std::string line;
+        };
+
+        std::unique_ptr<slot[]> slots;
+        usize mask;
+        LOG_OVERFLOW overflow;
+
+        alignas(64) std::atomic<u64> head = 0;
+        alignas(64) std::atomic<u64> written = 0;
+        std::atomic<u64> drop_count = 0;
+        std::atomic<bool> sleeping = false;
+        //where the writer's tail was when it went to sleep, producers wake it once the queue has filled wake_fill slots past it
+        std::atomic<u64> asleep_at = 0;
+        usize wake_fill;
+        std::atomic<bool> stopping = false;
+        std::atomic<u32> flushing = 0;
+
+        std::mutex lock;
+        std::condition_variable wake;
+        std::condition_variable drained;
+        std::thread writer;
+
+        void run();
+
+        //wakes a sleeping writer if the queue is filling up or the line is urgent, pos is the slot just published
+        void wakeWriter(u64 pos, bool urgent);
+
+    public:
+
+        //capacity is rounded up to a power of 2
+        explicit async_log_queue(usize capacity = 8192, LOG_OVERFLOW overflow = LOG_OVERFLOW_BLOCK);
+
+        async_log_queue(const async_log_queue&) = delete;
+
+        async_log_queue& operator =(const async_log_queue&) = delete;
+
+        //writes everything still queued and stops the writer
+        ~async_log_queue();
+
+        //queues a finished line for sink, which must outlive it, returns false if it was dropped
+        bool push(log_sink* sink, LOG_TYPE type, std::string_view line);
+
+        //returns once every line pushed before the call has been written
+        void flush();
+
+        NODISCARD usize capacity() const;
+
+        //the number of records dropped because the queue was full
+        NODISCARD u64 dropped() const;
+
+        //the queue loggers use when made async without one
+        static async_log_queue& global();
+    };
+
+
+    /*
+     * deferred logging, in the style of NanoLog
+     * a call site's format is a compile time constant, so the hot path only copies the raw argument bytes into a buffer owned
+     * by the calling thread, a background thread later turns them into text and writes them through the logger
+     * the format uses {} for each argument, arguments can be arithmetic types or anything convertible to std::string_view
+     */
+
+    //a format string usable as a template argument, lg.deferred<"took {} ms">(LOG_INFO, ms)
+    template<usize N>
+    struct log_format {
+        char text[N];
+
+        constexpr log_format(const char (&s)[N]) {
+            std::copy_n(s, N, text);
+        }
+    };
+
+    //how one argument type is copied into a record and turned into text on the background thread
+    template<typename T>
+    struct deferred_arg {
+        static_assert(std::is_arithmetic_v<T> || std::is_convertible_v<const T&, std::string_view>,
+                      "deferred log arguments must be arithmetic or convertible to std::string_view");
+
+        static std::string_view view(const T& x) {
+            if constexpr (std::is_pointer_v<T>) {
+                if (x == null) return "null";
+            }
+            return std::string_view(x);
+        }
+
+        static usize size(const T& x) {
+            if constexpr (std::is_arithmetic_v<T>) return sizeof(T);
+            else return sizeof(u32) + view(x).size();
+        }
+
+        static u8* encode(u8* p, const T& x) {
+            if constexpr (std::is_arithmetic_v<T>) {
+                std::memcpy(p, &x, sizeof(T));
+                return p + sizeof(T);
+            } else {
+                const std::string_view v = view(x);
+                const u32 n = cast(v.size(), u32);
+                std::memcpy(p, &n, sizeof(u32));
+                std::memcpy(p + sizeof(u32), v.data(), n);
+                return p + sizeof(u32) + n;
+            }
+        }
+
+        //formats the way std::ostream does by default, so deferred lines read the same as logger::log lines
+        static void decode(const u8*& p, std::string& out) {
+            if constexpr (std::is_arithmetic_v<T>) {
+                T x;
+                std::memcpy(&x, p, sizeof(T));
+                p += sizeof(T);
+                log_append(out, x);
+            } else {
+                u32 n;
+                std::memcpy(&n, p, sizeof(u32));
+                out.append(reinterpret_cast<const char*>(p + sizeof(u32)), n);
+                p += sizeof(u32) + n;
+            }
+        }
+    };
+
+    //appends the format with every {} replaced by the next argument, arguments past the last {} are appended at the end
+    template<typename... Args>
+    void deferred_format(std::string& out, const char* format, const u8* data) {
+        const auto next = [&]<typename T>(std::type_identity<T>) {
+            if (const char* hole = std::strstr(format, "{}"); hole != null) {
+                out.append(format, hole);
+                format = hole + 2;
+            } else {
+                out.append(format);
+                format = "";
+            }
+            deferred_arg<T>::decode(data, out);
+        };
+        (next(std::type_identity<std::remove_cvref_t<Args>>{}), ...);
+        out.append(format);
+    }
+
+    //one per call site, lives in a static local of logger_base::deferred
+    struct deferred_site {
+        const char* format;
+        void (*decode)(std::string& out, const char* format, const u8* data);
+    };
+
+    //reserves a record of args bytes in the calling thread's buffer and returns where the arguments go
+    extern AUSTINUTILS u8* deferred_begin(logger_base* owner, const deferred_site* site, LOG_TYPE type, usize args);
+
+    //publishes the record reserved by deferred_begin
+    extern AUSTINUTILS void deferred_commit();
+
+    //returns once every record committed before the call has been written
+    extern AUSTINUTILS void deferred_flush();
+
+    //true once any thread has logged a deferred record
+    NODISCARD extern AUSTINUTILS bool deferred_active();
+}
+
+#endif
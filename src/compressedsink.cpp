@@ -0,0 +1,95 @@
+#include "compressedsink.hpp"
+
+#include "Error.hpp"
+#include "logging.hpp"
+#include "lzcompress.hpp"
+
+
+namespace AustinUtils {
+
+    //the LOG_TYPE with a given severity
+    static LOG_TYPE severityToType(const int severity) {
+        constexpr LOG_TYPE types[] = {LOG_DEBUG, LOG_INFO, LOG_WARN, LOG_ERROR};
+        return types[severity];
+    }
+
+    compressed_sink_options::compressed_sink_options() : flush_on(LOG_ERROR) {}
+
+    compressed_sink::compressed_sink(std::shared_ptr<log_sink> target, const compressed_sink_options options) : target(std::move(target)), options(options) {
+        if (this->target == null) throw Exception("A compressed_sink needs a sink to write its frames to");
+        if (this->options.frame_bytes == 0) this->options.frame_bytes = 1;
+        if (this->options.frame_bytes >= 1u << 31) throw Exception("An lz frame holds less than 2GB, got frame_bytes ", this->options.frame_bytes);
+        active.reserve(this->options.frame_bytes);
+        spare.reserve(this->options.frame_bytes);
+        frame.reserve(LZ_FRAME_HEADER + lz_max_compressed_len(this->options.frame_bytes));
+    }
+
+    compressed_sink::~compressed_sink() {
+        flush();
+    }
+
+    void compressed_sink::output(const int severity, const std::string_view data) {
+        if (data.empty()) return;
+        frame.clear();
+        lz_frame_append(frame, data);
+        raw.fetch_add(data.size(), std::memory_order_relaxed);
+        compressed.fetch_add(frame.size(), std::memory_order_relaxed);
+        target->write(severityToType(severity), frame);
+    }
+
+    void compressed_sink::emit(std::unique_lock<std::mutex>& guard) {
+        std::unique_lock io(io_lock);
+        std::swap(active, spare);
+        const int severity = active_severity;
+        active_severity = 0;
+        guard.unlock();
+        output(severity, spare);
+        spare.clear();
+    }
+
+    void compressed_sink::write(const LOG_TYPE type, std::string_view lines) {
+        const bool urgent = LogSeverity(type) >= LogSeverity(options.flush_on);
+        std::unique_lock guard(lock);
+        active_severity = std::max(active_severity, LogSeverity(type));
+        //an async writer hands over whole batches, they are split so frames only ever end between lines
+        while (!lines.empty()) {
+            const usize room = options.frame_bytes - std::min(active.size(), options.frame_bytes);
+            usize take = lines.size();
+            if (take > room) {
+                const usize cut = room == 0 ? std::string_view::npos : lines.rfind('\n', room - 1);
+                take = cut == std::string_view::npos ? 0 : cut + 1;
+            }
+            if (take == 0 && active.empty()) {
+                //a line longer than a whole frame gets a frame of its own
+                const usize end = lines.find('\n');
+                take = end == std::string_view::npos ? lines.size() : end + 1;
+            }
+            active.append(lines.substr(0, take));
+            lines.remove_prefix(take);
+            if (!lines.empty() || active.size() >= options.frame_bytes) {
+                emit(guard);
+                guard.lock();
+                active_severity = LogSeverity(type);
+            }
+        }
+        if (urgent) emit(guard);
+    }
+
+    void compressed_sink::flush() {
+        std::unique_lock guard(lock);
+        emit(guard);
+        target->flush();
+    }
+
+    void compressed_sink::submit() {
+        target->submit();
+    }
+
+    u64 compressed_sink::raw_bytes() const {
+        return raw.load(std::memory_order_relaxed);
+    }
+
+    u64 compressed_sink::compressed_bytes() const {
+        return compressed.load(std::memory_order_relaxed);
+    }
+}
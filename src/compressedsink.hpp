@@ -0,0 +1,80 @@
+#ifndef COMPRESSEDSINK_HPP
+#define COMPRESSEDSINK_HPP
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include "misc.hpp"
+#include "logsink.hpp"
+
+#define AUSTINUTILS __declspec(dllexport)
+
+namespace AustinUtils {
+
+    enum LOG_TYPE : int;
+
+    struct compressed_sink_options {
+        //lines are collected until a frame of this many bytes is full and then compressed into one lz frame
+        usize frame_bytes = 1 << 16;
+        //lines at least this severe close the current frame straight away, even if it is small
+        LOG_TYPE flush_on;
+
+        compressed_sink_options();
+    };
+
+    /*
+     * compresses lines into lz frames (lzcompress.hpp) and writes each frame whole to another sink, usually a file_sink or uring_sink
+     * every frame decodes on its own, so a crash loses at most the frame being filled and a reader can skip a damaged one
+     * the target only ever sees whole frames, so a file_sink rotating on size still leaves every file readable, tools/lzcat.cpp decodes them
+     * like file_sink the full frame is swapped for a spare one before compressing, other threads keep appending meanwhile
+     */
+    class AUSTINUTILS compressed_sink : public log_sink {
+        std::shared_ptr<log_sink> target;
+        compressed_sink_options options;
+
+        std::mutex lock;
+        std::string active;
+        //the most severe level in active
+        int active_severity = 0;
+        //held while compressing and writing to target, taken before lock is released so frames keep the order the lines arrived in
+        std::mutex io_lock;
+        std::string spare;
+        std::string frame;
+
+        std::atomic<u64> raw = 0;
+        std::atomic<u64> compressed = 0;
+
+        //compresses data into one frame and writes it to target, io_lock must be held
+        void output(int severity, std::string_view data);
+
+        //swaps the active frame out and writes it, lock must be held and is released
+        void emit(std::unique_lock<std::mutex>& guard);
+
+    public:
+        explicit compressed_sink(std::shared_ptr<log_sink> target, compressed_sink_options options = compressed_sink_options());
+
+        compressed_sink(const compressed_sink&) = delete;
+
+        compressed_sink& operator =(const compressed_sink&) = delete;
+
+        //writes the partial frame out
+        ~compressed_sink() override;
+
+        void write(LOG_TYPE type, std::string_view lines) override;
+
+        //closes the partial frame, writes it and flushes the target
+        void flush() override;
+
+        //keeps the partial frame, so an async writer does not make a tiny frame every batch, and submits the target
+        void submit() override;
+
+        //the bytes of lines taken and the bytes of frames written so far
+        NODISCARD u64 raw_bytes() const;
+
+        NODISCARD u64 compressed_bytes() const;
+    };
+}
+
+#endif
@@ -0,0 +1,448 @@
+#include "encoding.hpp"
+
+#include "Error.hpp"
+
+#ifdef AUSTINUTILS_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef AUSTINUTILS_SSSE3
+#include <tmmintrin.h>
+#endif
+
+
+namespace AustinUtils {
+
+    static constexpr char hex_lower[] = "0123456789abcdef";
+    static constexpr char hex_upper[] = "0123456789ABCDEF";
+
+    static constexpr char base64_standard[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    static constexpr char base64_url[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+    struct base64_table {
+        u8 values[256];
+
+        constexpr explicit base64_table(const char* alphabet) : values() {
+            for (u8& v : values) v = 0xFF;
+            for (usize i = 0; i < 64; i++) values[cast(alphabet[i], u8)] = cast(i, u8);
+        }
+    };
+
+    static constexpr base64_table decode_standard(base64_standard);
+    static constexpr base64_table decode_url(base64_url);
+
+    static const char* alphabetChars(const BASE64_ALPHABET alphabet) {
+        return alphabet == BASE64_URL ? base64_url:base64_standard;
+    }
+
+    static const u8* alphabetValues(const BASE64_ALPHABET alphabet) {
+        return alphabet == BASE64_URL ? decode_url.values:decode_standard.values;
+    }
+
+    //appends n chars to out and hands op the start of the new region, streaming callers grow geometrically
+    template<typename Operation>
+    static void appendRegion(str& out, const usize n, const bool geometric, Operation op) {
+        const usize old = out.len();
+        if (geometric && old + n >= out.capacity()) out.resize(std::max(old + n + 1, out.capacity()*2));
+        out.resize_and_overwrite(old + n, [&](char* buffer, usize) {
+            op(buffer + old);
+            return old + n;
+        });
+    }
+
+
+
+    //hex
+
+    static void hexEncodeInto(const u8* src, const usize n, char* dst, const bool uppercase) {
+        const char* digits = uppercase ? hex_upper:hex_lower;
+        usize i = 0;
+
+#ifdef AUSTINUTILS_SSE2
+        const __m128i nibble = _mm_set1_epi8(0x0F);
+        const __m128i nine = _mm_set1_epi8(9);
+        const __m128i zero = _mm_set1_epi8('0');
+        const __m128i letter = _mm_set1_epi8(cast((uppercase ? 'A':'a') - '0' - 10, char));
+        for (; i + 16 <= n; i += 16) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), nibble);
+            __m128i lo = _mm_and_si128(v, nibble);
+            hi = _mm_add_epi8(_mm_add_epi8(hi, zero), _mm_and_si128(_mm_cmpgt_epi8(hi, nine), letter));
+            lo = _mm_add_epi8(_mm_add_epi8(lo, zero), _mm_and_si128(_mm_cmpgt_epi8(lo, nine), letter));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i*2), _mm_unpacklo_epi8(hi, lo));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i*2 + 16), _mm_unpackhi_epi8(hi, lo));
+        }
+#endif
+
+        for (; i < n; i++) {
+            dst[i*2] = digits[src[i] >> 4];
+            dst[i*2+1] = digits[src[i] & 0x0F];
+        }
+    }
+
+    static u8 hexValue(const char c, const usize index) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        throw Exception("Invalid hex character '", c, "' at index ", index);
+    }
+
+#ifdef AUSTINUTILS_SSE2
+    //converts 16 hex chars to their values, returns false if any of them is not a hex digit
+    static bool hexNibbles(const __m128i c, __m128i& out) {
+        const __m128i d = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+        const __m128i l = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+        //unsigned x <= limit is max(x, limit) == limit
+        const __m128i is_digit = _mm_cmpeq_epi8(_mm_max_epu8(d, _mm_set1_epi8(9)), _mm_set1_epi8(9));
+        const __m128i is_letter = _mm_cmpeq_epi8(_mm_max_epu8(l, _mm_set1_epi8(5)), _mm_set1_epi8(5));
+        if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) != 0xFFFF) return false;
+
+        out = _mm_or_si128(_mm_and_si128(is_digit, d), _mm_andnot_si128(is_digit, _mm_add_epi8(l, _mm_set1_epi8(10))));
+        return true;
+    }
+
+    static __m128i hexCombine(const __m128i nibbles) {
+        //each 16 bit lane holds the high nibble in its low byte and the low nibble in its high byte
+        return _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00FF)), 4), _mm_srli_epi16(nibbles, 8));
+    }
+#endif
+
+    static void hexDecodeInto(const char* src, const usize n, u8* dst, const usize index_base) {
+        usize i = 0;
+
+#ifdef AUSTINUTILS_SSE2
+        for (; i + 32 <= n; i += 32) {
+            __m128i a, b;
+            if (!hexNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), a)) break;
+            if (!hexNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 16)), b)) break;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i/2), _mm_packus_epi16(hexCombine(a), hexCombine(b)));
+        }
+#endif
+
+        //the scalar loop also reports the exact position of anything the vector loop rejected
+        for (; i + 2 <= n; i += 2) {
+            dst[i/2] = cast(hexValue(src[i], index_base + i) << 4 | hexValue(src[i+1], index_base + i + 1), u8);
+        }
+    }
+
+    void hex_encode(const void* data, const usize n, str& out, const bool uppercase) {
+        appendRegion(out, hex_encoded_len(n), false, [&](char* dst) {
+            hexEncodeInto(static_cast<const u8*>(data), n, dst, uppercase);
+        });
+    }
+
+    str hex_encode(const std::string_view data, const bool uppercase) {
+        str ret;
+        hex_encode(data.data(), data.size(), ret, uppercase);
+        return ret;
+    }
+
+    void hex_decode(const std::string_view hex, str& out) {
+        if (hex.size() % 2 != 0) throw Exception("Hex string has an odd length of ", hex.size());
+        appendRegion(out, hex.size()/2, false, [&](char* dst) {
+            hexDecodeInto(hex.data(), hex.size(), reinterpret_cast<u8*>(dst), 0);
+        });
+    }
+
+    str hex_decode(const std::string_view hex) {
+        str ret;
+        hex_decode(hex, ret);
+        return ret;
+    }
+
+    void hex_decoder::update(std::string_view chunk, str& out) {
+        if (chunk.empty()) return;
+        if (has_pending) {
+            const char pair[2] = {pending, chunk[0]};
+            appendRegion(out, 1, true, [&](char* dst) {
+                hexDecodeInto(pair, 2, reinterpret_cast<u8*>(dst), 0);
+            });
+            has_pending = false;
+            chunk.remove_prefix(1);
+        }
+
+        const usize full = chunk.size() & ~cast(1, usize);
+        if (full > 0) {
+            appendRegion(out, full/2, true, [&](char* dst) {
+                hexDecodeInto(chunk.data(), full, reinterpret_cast<u8*>(dst), 0);
+            });
+        }
+        if (full < chunk.size()) {
+            pending = chunk.back();
+            has_pending = true;
+        }
+    }
+
+    void hex_decoder::finish() {
+        if (has_pending) {
+            has_pending = false;
+            throw Exception("Hex input ended with an odd number of characters");
+        }
+    }
+
+
+
+    //base64
+
+#ifdef AUSTINUTILS_SSSE3
+    //maps 16 6-bit indices to their chars without any table lookups per char
+    static __m128i base64Chars(const __m128i indices, const BASE64_ALPHABET alphabet) {
+        const __m128i shift = alphabet == BASE64_URL
+            ? _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                            '0' - 52, '0' - 52, '0' - 52, '-' - 62, '_' - 63, 'A', 0, 0)
+            : _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                            '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+        __m128i result = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+        result = _mm_or_si128(result, _mm_and_si128(less, _mm_set1_epi8(13)));
+        return _mm_add_epi8(_mm_shuffle_epi8(shift, result), indices);
+    }
+
+    //encodes the first 12 bytes of in into 16 chars
+    static __m128i base64Encode12(__m128i in, const BASE64_ALPHABET alphabet) {
+        in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+        const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+        const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+        const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+        const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+        return base64Chars(_mm_or_si128(t1, t3), alphabet);
+    }
+
+    //decodes 16 chars into 12 bytes in the low lanes of out, returns false if any char is outside the alphabet
+    static bool base64Decode16(const __m128i in, const BASE64_ALPHABET alphabet, __m128i& out) {
+        //the high nibble of a char picks the range it has to fall in and the offset that maps it to its value
+        const __m128i hi = _mm_and_si128(_mm_srli_epi32(in, 4), _mm_set1_epi8(0x0F));
+        const bool url = alphabet == BASE64_URL;
+        const char c62 = url ? '-':'+';
+        const __m128i lower_lut = _mm_setr_epi8(1, 1, c62, '0', 'A', 'P', 'a', 'p', 1, 1, 1, 1, 1, 1, 1, 1);
+        const __m128i upper_lut = _mm_setr_epi8(0, 0, c62, '9', 'O', 'Z', 'o', 'z', 0, 0, 0, 0, 0, 0, 0, 0);
+        const __m128i shift_lut = _mm_setr_epi8(0, 0, cast(62 - c62, char), 52 - '0', 0 - 'A', 15 - 'P', 26 - 'a', 41 - 'p',
+                                                0, 0, 0, 0, 0, 0, 0, 0);
+
+        //char 63 shares its high nibble with a range, so it is matched separately
+        const char c63 = url ? '_':'/';
+        const char fix63 = cast(63 - (c63 + (url ? 15 - 'P' : 62 - c62)), char);
+        const __m128i is63 = _mm_cmpeq_epi8(in, _mm_set1_epi8(c63));
+
+        const __m128i below = _mm_cmplt_epi8(in, _mm_shuffle_epi8(lower_lut, hi));
+        const __m128i above = _mm_cmpgt_epi8(in, _mm_shuffle_epi8(upper_lut, hi));
+        if (_mm_movemask_epi8(_mm_andnot_si128(is63, _mm_or_si128(below, above))) != 0) return false;
+
+        __m128i values = _mm_add_epi8(in, _mm_shuffle_epi8(shift_lut, hi));
+        values = _mm_add_epi8(values, _mm_and_si128(is63, _mm_set1_epi8(fix63)));
+
+        //pack the 6 bit values together, 4 of them into 3 bytes
+        const __m128i ab_bc = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        const __m128i packed = _mm_madd_epi16(ab_bc, _mm_set1_epi32(0x00011000));
+        out = _mm_shuffle_epi8(packed, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        return true;
+    }
+#endif
+
+    //encodes every complete 3 byte group, returns the number of bytes consumed
+    static usize base64EncodeGroups(const u8* src, const usize n, char* dst, const BASE64_ALPHABET alphabet) {
+        const char* chars = alphabetChars(alphabet);
+        usize i = 0, o = 0;
+
+#ifdef AUSTINUTILS_SSSE3
+        //each step reads 16 bytes but only consumes 12
+        for (; i + 16 <= n; i += 12, o += 16) {
+            const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + o), base64Encode12(in, alphabet));
+        }
+#endif
+
+        for (; i + 3 <= n; i += 3, o += 4) {
+            const u32 v = cast(src[i], u32) << 16 | cast(src[i+1], u32) << 8 | src[i+2];
+            dst[o] = chars[v >> 18];
+            dst[o+1] = chars[(v >> 12) & 0x3F];
+            dst[o+2] = chars[(v >> 6) & 0x3F];
+            dst[o+3] = chars[v & 0x3F];
+        }
+        return i;
+    }
+
+    //encodes the last 1 or 2 bytes
+    static void base64EncodeTail(const u8* src, const usize n, char* dst, const BASE64_ALPHABET alphabet, const bool pad) {
+        const char* chars = alphabetChars(alphabet);
+        if (n == 0) return;
+
+        const u32 v = cast(src[0], u32) << 16 | (n > 1 ? cast(src[1], u32) << 8 : 0);
+        dst[0] = chars[v >> 18];
+        dst[1] = chars[(v >> 12) & 0x3F];
+        if (n > 1) dst[2] = chars[(v >> 6) & 0x3F];
+        else if (pad) dst[2] = '=';
+        if (pad) dst[3] = '=';
+    }
+
+    static usize base64DecodedLen(const usize n) {
+        return n/4*3 + (n%4 == 0 ? 0 : n%4 - 1);
+    }
+
+    //decodes n chars without padding, n % 4 can not be 1
+    static void base64DecodeInto(const char* src, const usize n, u8* dst, const BASE64_ALPHABET alphabet) {
+        if (n % 4 == 1) throw Exception("Truncated base64 input of length ", n);
+        const u8* values = alphabetValues(alphabet);
+        usize i = 0, o = 0;
+
+#ifdef AUSTINUTILS_SSSE3
+        //each step writes 16 bytes but only 12 are real, the loop bound keeps the extra 4 inside the output
+        for (; i + 24 <= n; i += 16, o += 12) {
+            __m128i out;
+            if (!base64Decode16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), alphabet, out)) break;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + o), out);
+        }
+#endif
+
+        const auto value = [&](const usize at) -> u32 {
+            const u8 v = values[cast(src[at], u8)];
+            if (v == 0xFF) throw Exception("Invalid base64 character '", src[at], "' at index ", at);
+            return v;
+        };
+
+        for (; i + 4 <= n; i += 4, o += 3) {
+            const u32 v = value(i) << 18 | value(i+1) << 12 | value(i+2) << 6 | value(i+3);
+            dst[o] = cast(v >> 16, u8);
+            dst[o+1] = cast(v >> 8, u8);
+            dst[o+2] = cast(v, u8);
+        }
+        if (i + 2 <= n) {
+            u32 v = value(i) << 18 | value(i+1) << 12;
+            if (i + 3 == n) v |= value(i+2) << 6;
+            dst[o] = cast(v >> 16, u8);
+            if (i + 3 == n) dst[o+1] = cast(v >> 8, u8);
+        }
+    }
+
+    void base64_encode(const void* data, const usize n, str& out, const BASE64_ALPHABET alphabet, const bool pad) {
+        const u8* src = static_cast<const u8*>(data);
+        appendRegion(out, base64_encoded_len(n, pad), false, [&](char* dst) {
+            const usize done = base64EncodeGroups(src, n, dst, alphabet);
+            base64EncodeTail(src + done, n - done, dst + done/3*4, alphabet, pad);
+        });
+    }
+
+    str base64_encode(const std::string_view data, const BASE64_ALPHABET alphabet, const bool pad) {
+        str ret;
+        base64_encode(data.data(), data.size(), ret, alphabet, pad);
+        return ret;
+    }
+
+    void base64_decode(std::string_view b64, str& out, const BASE64_ALPHABET alphabet) {
+        if (b64.size() % 4 == 0 && b64.ends_with('=')) b64.remove_suffix(b64.ends_with("==") ? 2:1);
+
+        appendRegion(out, base64DecodedLen(b64.size()), false, [&](char* dst) {
+            base64DecodeInto(b64.data(), b64.size(), reinterpret_cast<u8*>(dst), alphabet);
+        });
+    }
+
+    str base64_decode(const std::string_view b64, const BASE64_ALPHABET alphabet) {
+        str ret;
+        base64_decode(b64, ret, alphabet);
+        return ret;
+    }
+
+
+
+    base64_encoder::base64_encoder(const BASE64_ALPHABET alphabet, const bool pad) : alphabet(alphabet), pad(pad) {}
+
+    void base64_encoder::update(const void* data, usize n, str& out) {
+        const u8* src = static_cast<const u8*>(data);
+
+        if (npending > 0) {
+            u8 group[3] = {pending[0], pending[1], 0};
+            while (npending < 3 && n > 0) {
+                group[npending++] = *src++;
+                n--;
+            }
+            if (npending < 3) {
+                pending[0] = group[0];
+                pending[1] = group[1];
+                return;
+            }
+            appendRegion(out, 4, true, [&](char* dst) {
+                base64EncodeGroups(group, 3, dst, alphabet);
+            });
+            npending = 0;
+        }
+
+        const usize full = n/3*3;
+        if (full > 0) {
+            appendRegion(out, full/3*4, true, [&](char* dst) {
+                base64EncodeGroups(src, full, dst, alphabet);
+            });
+        }
+        for (usize i = full; i < n; i++) pending[npending++] = src[i];
+    }
+
+    void base64_encoder::finish(str& out) {
+        if (npending > 0) {
+            appendRegion(out, base64_encoded_len(npending, pad), true, [&](char* dst) {
+                base64EncodeTail(pending, npending, dst, alphabet, pad);
+            });
+        }
+        npending = 0;
+    }
+
+
+
+    base64_decoder::base64_decoder(const BASE64_ALPHABET alphabet) : alphabet(alphabet) {}
+
+    //decodes a complete group that may end in padding, padding ends the stream
+    static bool base64DecodeGroup(const char group[4], str& out, const BASE64_ALPHABET alphabet) {
+        usize n = 4;
+        while (n > 2 && group[n-1] == '=') n--;
+
+        appendRegion(out, base64DecodedLen(n), true, [&](char* dst) {
+            base64DecodeInto(group, n, reinterpret_cast<u8*>(dst), alphabet);
+        });
+        return n < 4;
+    }
+
+    void base64_decoder::update(std::string_view chunk, str& out) {
+        if (done) {
+            if (!chunk.empty()) throw Exception("Base64 input continues after padding");
+            return;
+        }
+
+        if (npending > 0) {
+            while (npending < 4 && !chunk.empty()) {
+                pending[npending++] = chunk[0];
+                chunk.remove_prefix(1);
+            }
+            if (npending < 4) return;
+            npending = 0;
+            done = base64DecodeGroup(pending, out, alphabet);
+            if (done && !chunk.empty()) throw Exception("Base64 input continues after padding");
+        }
+
+        //a group holding padding has to be the last one, so it goes through the group path
+        usize full = chunk.size()/4*4;
+        if (full > 0 && chunk[full-1] == '=') {
+            if (full != chunk.size()) throw Exception("Base64 input continues after padding");
+            full -= 4;
+        }
+        if (full > 0) {
+            appendRegion(out, full/4*3, true, [&](char* dst) {
+                base64DecodeInto(chunk.data(), full, reinterpret_cast<u8*>(dst), alphabet);
+            });
+        }
+
+        for (usize i = full; i < chunk.size(); i++) pending[npending++] = chunk[i];
+        if (npending == 4) {
+            npending = 0;
+            done = base64DecodeGroup(pending, out, alphabet);
+        }
+    }
+
+    void base64_decoder::finish(str& out) {
+        const usize n = npending;
+        npending = 0;
+        done = false;
+        if (n == 0) return;
+        if (n == 1) throw Exception("Truncated base64 input");
+
+        appendRegion(out, base64DecodedLen(n), true, [&](char* dst) {
+            base64DecodeInto(pending, n, reinterpret_cast<u8*>(dst), alphabet);
+        });
+    }
+}
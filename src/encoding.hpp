@@ -0,0 +1,100 @@
+#ifndef ENCODING_HPP
+#define ENCODING_HPP
+
+#include <string_view>
+#include "misc.hpp"
+#include "str.hpp"
+
+#define AUSTINUTILS __declspec(dllexport)
+
+//vectorized hex and base64 codecs, every routine sizes the destination str exactly once before writing into it
+
+namespace AustinUtils {
+
+    enum BASE64_ALPHABET {
+        BASE64_STANDARD,
+        BASE64_URL
+    };
+
+    //returns the number of chars hex_encode produces for n bytes
+    NODISCARD constexpr usize hex_encoded_len(const usize n) {
+        return n*2;
+    }
+
+    //returns the number of chars base64_encode produces for n bytes
+    NODISCARD constexpr usize base64_encoded_len(const usize n, const bool pad = true) {
+        return pad ? (n+2)/3*4 : n/3*4 + (n%3 == 0 ? 0 : n%3+1);
+    }
+
+    //appends the hex encoding of the n bytes at data to out
+    extern AUSTINUTILS void hex_encode(const void* data, usize n, str& out, bool uppercase = false);
+
+    NODISCARD extern AUSTINUTILS str hex_encode(std::string_view data, bool uppercase = false);
+
+    //appends the bytes encoded by hex to out, throws if hex has an odd length or a non-hex char
+    extern AUSTINUTILS void hex_decode(std::string_view hex, str& out);
+
+    NODISCARD extern AUSTINUTILS str hex_decode(std::string_view hex);
+
+    //appends the base64 encoding of the n bytes at data to out
+    extern AUSTINUTILS void base64_encode(const void* data, usize n, str& out, BASE64_ALPHABET alphabet = BASE64_STANDARD, bool pad = true);
+
+    NODISCARD extern AUSTINUTILS str base64_encode(std::string_view data, BASE64_ALPHABET alphabet = BASE64_STANDARD, bool pad = true);
+
+    //appends the bytes encoded by b64 to out, padding is optional, throws on any char outside the alphabet
+    extern AUSTINUTILS void base64_decode(std::string_view b64, str& out, BASE64_ALPHABET alphabet = BASE64_STANDARD);
+
+    NODISCARD extern AUSTINUTILS str base64_decode(std::string_view b64, BASE64_ALPHABET alphabet = BASE64_STANDARD);
+
+
+    //streaming codecs for chunked input, chunks can be split anywhere
+
+    class AUSTINUTILS hex_decoder {
+        char pending = '\0';
+        bool has_pending = false;
+
+    public:
+
+        //decodes as much of chunk as possible and appends it to out
+        void update(std::string_view chunk, str& out);
+
+        //throws if an odd number of chars was fed in total
+        void finish();
+    };
+
+    class AUSTINUTILS base64_encoder {
+        u8 pending[2] = {};
+        usize npending = 0;
+        BASE64_ALPHABET alphabet;
+        bool pad;
+
+    public:
+
+        explicit base64_encoder(BASE64_ALPHABET alphabet = BASE64_STANDARD, bool pad = true);
+
+        //encodes every complete 3 byte group and appends it to out
+        void update(const void* data, usize n, str& out);
+
+        //encodes the remaining bytes and resets the encoder
+        void finish(str& out);
+    };
+
+    class AUSTINUTILS base64_decoder {
+        char pending[4] = {};
+        usize npending = 0;
+        bool done = false;
+        BASE64_ALPHABET alphabet;
+
+    public:
+
+        explicit base64_decoder(BASE64_ALPHABET alphabet = BASE64_STANDARD);
+
+        //decodes every complete 4 char group and appends it to out
+        void update(std::string_view chunk, str& out);
+
+        //decodes an unpadded tail and resets the decoder, throws if the input was truncated
+        void finish(str& out);
+    };
+}
+
+#endif
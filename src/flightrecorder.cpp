@@ -0,0 +1,292 @@
+#include "flightrecorder.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <csignal>
+#include <cstring>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "Error.hpp"
+#include "logging.hpp"
+#include "logsink.hpp"
+
+
+namespace AustinUtils {
+
+    //in front of every slot, sequence is the record's index + 1 once it is complete and 0 while it is being written
+    struct record_header {
+        std::atomic<u64> sequence = 0;
+        u32 size = 0;
+        LOG_TYPE type = LOG_INFO;
+    };
+
+    struct flight_recorder::ring {
+        std::unique_ptr<u8[]> data;
+        usize records;
+        usize stride;
+        //changes when the ring of an exited thread is handed to a new one
+        std::atomic<u64> thread;
+        //only ever written by the thread the ring belongs to
+        std::atomic<u64> next = 0;
+        std::atomic<u64> dumped = 0;
+        std::atomic<bool> retired = false;
+
+        ring(const usize records, const usize record_bytes, const u64 thread) : records(records), thread(thread) {
+            stride = (sizeof(record_header) + record_bytes + 7) & ~cast(7, usize);
+            data = std::make_unique<u8[]>(records * stride);
+            for (usize i = 0; i < records; i++) new (data.get() + i * stride) record_header();
+        }
+
+        //hands the ring of an exited thread to owner, the object stays where dump_fd can reach it, only its records are cleared
+        void reuse(const u64 owner) {
+            for (usize i = 0; i < records; i++) at(i)->sequence.store(0, std::memory_order_relaxed);
+            dumped.store(next.load());
+            thread.store(owner, std::memory_order_relaxed);
+            retired.store(false);
+        }
+
+        record_header* at(const u64 i) const {
+            return reinterpret_cast<record_header*>(data.get() + (i % records) * stride);
+        }
+
+        static const char* text(const record_header* h) {
+            return reinterpret_cast<const char*>(h + 1);
+        }
+    };
+
+    //the rings of the calling thread, one per recorder it has recorded into, retired when the thread exits
+    struct recorder_local {
+        u64 id;
+        std::shared_ptr<flight_recorder::ring> ring;
+    };
+
+    struct recorder_locals {
+        std::vector<recorder_local> rings;
+
+        ~recorder_locals() {
+            for (const recorder_local& l : rings) {
+                if (l.ring != null) l.ring->retired.store(true);
+            }
+        }
+    };
+
+    static thread_local recorder_locals locals;
+    static std::atomic<u64> next_id = 1;
+
+    flight_recorder::flight_recorder(const usize records, const usize record_bytes) : records(std::max<usize>(records, 1)),
+                                                                                      record_bytes(std::max<usize>(record_bytes, 1)),
+                                                                                      id(next_id.fetch_add(1)) {}
+
+    flight_recorder::ring* flight_recorder::local() {
+        for (const recorder_local& l : locals.rings) {
+            if (l.id == id) return l.ring.get();
+        }
+
+        std::shared_ptr<ring> r;
+        {
+            std::lock_guard guard(lock);
+            usize i = 0;
+            while (i < max_threads && owned[i] != null) i++;
+            if (i < max_threads) {
+                r = std::make_shared<ring>(records, record_bytes, log_thread_id());
+                rings[i].store(r.get(), std::memory_order_release);
+                owned[i] = r;
+            } else {
+                //every slot is taken, the ring of a thread that has exited is recycled in place, freeing it could pull it out from under dump_fd
+                i = 0;
+                while (i < max_threads && !owned[i]->retired.load()) i++;
+                if (i < max_threads) {
+                    r = owned[i];
+                    r->reuse(log_thread_id());
+                }
+            }
+        }
+        locals.rings.push_back({id, r});
+        return r.get();
+    }
+
+    void flight_recorder::record(const LOG_TYPE type, const std::string_view line) {
+        ring* r = local();
+        if (r == null) return;
+        const u64 i = r->next.load(std::memory_order_relaxed);
+        record_header* h = r->at(i);
+        h->sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        const usize n = std::min(line.size(), record_bytes);
+        char* text = reinterpret_cast<char*>(h + 1);
+        std::memcpy(text, line.data(), n);
+        if (n < line.size()) text[n - 1] = '\n';
+        h->size = cast(n, u32);
+        h->type = type;
+        h->sequence.store(i + 1, std::memory_order_release);
+        r->next.store(i + 1, std::memory_order_release);
+    }
+
+    //writes r's records since its last dump, reason is put in the first line if given
+    static void dumpRing(flight_recorder::ring& r, log_sink& sink, const std::string_view reason = {}) {
+        const u64 end = r.next.load(std::memory_order_acquire);
+        const u64 begin = std::max(r.dumped.load(), end > r.records ? end - r.records : 0);
+        if (begin >= end) return;
+
+        std::string out;
+        out.append("----- flight recorder: thread ").append(std::to_string(r.thread.load(std::memory_order_relaxed))).append(", last ").append(std::to_string(end - begin));
+        out.append(" records");
+        if (!reason.empty()) out.append(" before: ").append(reason);
+        out.append(" -----\n");
+        for (u64 i = begin; i < end; i++) {
+            const record_header* h = r.at(i);
+            const u64 sequence = h->sequence.load(std::memory_order_acquire);
+            if (sequence != i + 1) continue;
+            const usize start = out.size();
+            out.append(flight_recorder::ring::text(h), h->size);
+            //overwritten while it was being copied
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (h->sequence.load(std::memory_order_relaxed) != sequence) out.resize(start);
+        }
+        out.append("----- end of flight recorder -----\n");
+        sink.write(LOG_ERROR, out);
+        sink.flush();
+        r.dumped.store(end);
+    }
+
+    void flight_recorder::dump_thread(log_sink& sink) {
+        if (ring* r = local(); r != null) dumpRing(*r, sink);
+    }
+
+    void flight_recorder::dump(log_sink& sink) {
+        std::lock_guard guard(lock);
+        for (const std::shared_ptr<ring>& r : owned) {
+            if (r != null) dumpRing(*r, sink);
+        }
+    }
+
+    static void writeAll(const int fd, const char* data, usize n) {
+        while (n > 0) {
+#ifdef _WIN32
+            const auto written = ::_write(fd, data, cast(n, unsigned));
+#else
+            const auto written = ::write(fd, data, n);
+#endif
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return;
+            }
+            data += written;
+            n -= written;
+        }
+    }
+
+    void flight_recorder::dump_fd(const int fd) const noexcept {
+        for (const std::atomic<ring*>& slot : rings) {
+            const ring* r = slot.load(std::memory_order_acquire);
+            if (r == null) continue;
+
+            //no allocation and no stdio, only write is safe in a signal handler
+            char line[64];
+            constexpr std::string_view start = "----- flight recorder: thread ";
+            constexpr std::string_view stop = " -----\n";
+            std::memcpy(line, start.data(), start.size());
+            char* p = std::to_chars(line + start.size(), line + sizeof(line) - stop.size(), r->thread.load(std::memory_order_relaxed)).ptr;
+            std::memcpy(p, stop.data(), stop.size());
+            writeAll(fd, line, p + stop.size() - line);
+
+            const u64 end = r->next.load(std::memory_order_acquire);
+            for (u64 i = end > r->records ? end - r->records : 0; i < end; i++) {
+                const record_header* h = r->at(i);
+                if (h->sequence.load(std::memory_order_acquire) == i + 1) writeAll(fd, ring::text(h), h->size);
+            }
+            constexpr std::string_view done = "----- end of flight recorder -----\n";
+            writeAll(fd, done.data(), done.size());
+        }
+    }
+
+
+    static std::atomic<flight_recorder*> error_recorder = null;
+
+    void flight_recorder::onError(const Error& error) {
+        flight_recorder* recorder = error_recorder.load();
+        if (recorder == null) return;
+        std::shared_ptr<log_sink> sink;
+        {
+            std::lock_guard guard(recorder->lock);
+            sink = recorder->error_sink;
+        }
+        if (sink == null) return;
+        //a thread that never recorded has nothing to show, do not give it a ring now
+        for (const recorder_local& l : locals.rings) {
+            if (l.id == recorder->id && l.ring != null) dumpRing(*l.ring, *sink, error.std::runtime_error::what());
+        }
+    }
+
+    void flight_recorder::dump_on_error(std::shared_ptr<log_sink> sink) {
+        std::lock_guard guard(lock);
+        error_sink = std::move(sink);
+        if (error_sink != null) {
+            error_recorder.store(this);
+            SetErrorHook(&flight_recorder::onError);
+        } else {
+            flight_recorder* self = this;
+            if (error_recorder.compare_exchange_strong(self, null)) SetErrorHook(null);
+        }
+    }
+
+
+    static std::atomic<const flight_recorder*> signal_recorder = null;
+    static int signal_fd = 2;
+
+#ifdef _WIN32
+    static constexpr int fatal_signals[] = {SIGSEGV, SIGFPE, SIGILL, SIGABRT};
+#else
+    static constexpr int fatal_signals[] = {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT};
+    static struct sigaction previous_actions[std::size(fatal_signals)];
+#endif
+
+    static void onSignal(const int sig) {
+        //only the first fatal signal dumps, a crash while dumping goes straight through
+        if (const flight_recorder* recorder = signal_recorder.exchange(null); recorder != null) recorder->dump_fd(signal_fd);
+        for (usize i = 0; i < std::size(fatal_signals); i++) {
+            if (fatal_signals[i] != sig) continue;
+#ifdef _WIN32
+            std::signal(sig, SIG_DFL);
+#else
+            sigaction(sig, &previous_actions[i], null);
+#endif
+        }
+        std::raise(sig);
+    }
+
+    void flight_recorder::dump_on_signal(const int fd) {
+        signal_fd = fd;
+        if (signal_recorder.exchange(this) != null) return;
+        for (usize i = 0; i < std::size(fatal_signals); i++) {
+#ifdef _WIN32
+            std::signal(fatal_signals[i], onSignal);
+#else
+            struct sigaction action = {};
+            action.sa_handler = onSignal;
+            sigemptyset(&action.sa_mask);
+            sigaction(fatal_signals[i], &action, &previous_actions[i]);
+#endif
+        }
+    }
+
+    flight_recorder::~flight_recorder() {
+        flight_recorder* self = this;
+        if (error_recorder.compare_exchange_strong(self, null)) SetErrorHook(null);
+        const flight_recorder* me = this;
+        signal_recorder.compare_exchange_strong(me, null);
+    }
+
+    flight_recorder& flight_recorder::global() {
+        static flight_recorder recorder;
+        return recorder;
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef FLIGHTRECORDER_HPP
+#define FLIGHTRECORDER_HPP
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include "misc.hpp"
+
+#define AUSTINUTILS __declspec(dllexport)
+
+/*
+ * keeps the last records of every thread in memory, including levels too verbose to write out, so the context that led up to
+ * an Error or a crash can be dumped when it happens
+ * each thread copies its finished lines into a ring of fixed size slots of its own, recording a line is one memcpy and no locks
+ */
+
+namespace AustinUtils {
+
+    enum LOG_TYPE : int;
+    class log_sink;
+    class Error;
+
+    class AUSTINUTILS flight_recorder {
+    public:
+        struct ring;
+
+        //rings beyond this many live threads are not created, their records are dropped, the ring of an exited thread is reused
+        static constexpr usize max_threads = 256;
+
+    private:
+        usize records;
+        usize record_bytes;
+        u64 id;
+
+        //the rings as plain pointers, for the signal handler, owned holds the same rings
+        std::atomic<ring*> rings[max_threads] = {};
+        std::shared_ptr<ring> owned[max_threads];
+        std::mutex lock;
+        std::shared_ptr<log_sink> error_sink;
+
+        ring* local();
+
+        static void onError(const Error& error);
+
+    public:
+
+        //every thread that records gets records slots of record_bytes, longer lines are cut short
+        explicit flight_recorder(usize records = 512, usize record_bytes = 256);
+
+        flight_recorder(const flight_recorder&) = delete;
+
+        flight_recorder& operator =(const flight_recorder&) = delete;
+
+        ~flight_recorder();
+
+        //copies a finished line into the calling thread's ring, overwriting the oldest record once it is full
+        void record(LOG_TYPE type, std::string_view line);
+
+        //writes what the calling thread recorded since its last dump to sink, oldest first
+        void dump_thread(log_sink& sink);
+
+        //writes what every thread recorded since its last dump to sink, one thread after the other
+        void dump(log_sink& sink);
+
+        //writes every thread's records to fd using only write, safe to call from a signal handler, records are not marked as dumped
+        void dump_fd(int fd) const noexcept;
+
+        //whenever an Error is constructed, writes the constructing thread's records since its last dump to sink, null stops it
+        void dump_on_error(std::shared_ptr<log_sink> sink);
+
+        //on SIGSEGV, SIGBUS, SIGFPE, SIGILL and SIGABRT writes every thread's records to fd, then lets the signal do what it did before
+        void dump_on_signal(int fd = 2);
+
+        static flight_recorder& global();
+    };
+}
+
+#endif
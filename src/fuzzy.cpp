@@ -0,0 +1,266 @@
+#include "fuzzy.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+#include "threadpool.hpp"
+
+#ifdef AUSTINUTILS_AVX2
+#include <immintrin.h>
+#endif
+
+
+namespace AustinUtils {
+
+    static constexpr usize unlimited = str::npos;
+
+    static usize distanceBound(const usize max) {
+        return max == unlimited ? unlimited : max+1;
+    }
+
+    //one column of the dp matrix for a pattern of at most 64 chars
+    struct myers_word {
+        u64 pv = ~0ULL;
+        u64 mv = 0;
+
+        //advances one text char, returns the change of the last row
+        int step(u64 eq, const u64 last) {
+            const u64 xv = eq | mv;
+            const u64 xh = (((eq & pv) + pv) ^ pv) | eq;
+            u64 ph = mv | ~(xh | pv);
+            u64 mh = pv & xh;
+            const int delta = (ph & last) ? 1 : (mh & last) ? -1 : 0;
+            //the first row of the matrix grows by one per column
+            ph = (ph << 1) | 1;
+            mh <<= 1;
+            pv = mh | ~(xv | ph);
+            mv = ph & xv;
+            return delta;
+        }
+    };
+
+    static usize myersSingle(const std::string_view pattern, const std::string_view text, const usize max) {
+        u64 peq[256] = {};
+        for (usize i = 0; i < pattern.size(); i++) peq[cast(pattern[i], u8)] |= 1ULL << i;
+
+        const u64 last = 1ULL << (pattern.size()-1);
+        myers_word column;
+        usize score = pattern.size();
+        for (usize j = 0; j < text.size(); j++) {
+            score += column.step(peq[cast(text[j], u8)], last);
+            //every remaining column can lower the score by at most one
+            if (max != unlimited && score > max + (text.size() - j - 1)) return max+1;
+        }
+        return score;
+    }
+
+    static usize myersBlocks(const std::string_view pattern, const std::string_view text, const usize max) {
+        const usize blocks = (pattern.size() + 63) / 64;
+        std::vector<u64> peq(256 * blocks, 0);
+        for (usize i = 0; i < pattern.size(); i++) peq[cast(pattern[i], u8) * blocks + i/64] |= 1ULL << (i % 64);
+
+        std::vector<u64> pv(blocks, ~0ULL), mv(blocks, 0);
+        const u64 last = 1ULL << ((pattern.size()-1) % 64);
+        usize score = pattern.size();
+
+        for (usize j = 0; j < text.size(); j++) {
+            const u64* eqs = &peq[cast(text[j], u8) * blocks];
+            //the horizontal delta carried from the block above, the first row always grows by one
+            int hin = 1;
+            for (usize b = 0; b < blocks; b++) {
+                u64 eq = eqs[b];
+                const u64 high = b == blocks-1 ? last : 1ULL << 63;
+                const u64 xv = eq | mv[b];
+                if (hin < 0) eq |= 1;
+                const u64 xh = (((eq & pv[b]) + pv[b]) ^ pv[b]) | eq;
+                u64 ph = mv[b] | ~(xh | pv[b]);
+                u64 mh = pv[b] & xh;
+                const int hout = (ph & high) ? 1 : (mh & high) ? -1 : 0;
+                ph <<= 1;
+                mh <<= 1;
+                if (hin < 0) mh |= 1;
+                else if (hin > 0) ph |= 1;
+                pv[b] = mh | ~(xv | ph);
+                mv[b] = ph & xv;
+                hin = hout;
+            }
+            score += hin;
+            if (max != unlimited && score > max + (text.size() - j - 1)) return max+1;
+        }
+        return score;
+    }
+
+    usize edit_distance(const std::string_view a, const std::string_view b, const usize max) {
+        //the shorter string is the pattern so it takes as few words as possible
+        const std::string_view pattern = a.size() <= b.size() ? a:b;
+        const std::string_view text = a.size() <= b.size() ? b:a;
+
+        if (max != unlimited && text.size() - pattern.size() > max) return max+1;
+        if (pattern.empty()) return text.size();
+
+        return pattern.size() <= 64 ? myersSingle(pattern, text, max) : myersBlocks(pattern, text, max);
+    }
+
+    usize edit_distance(const std::string_view a, const std::string_view b) {
+        return edit_distance(a, b, unlimited);
+    }
+
+    usize edit_distance(const str& a, const str& b) {
+        return edit_distance(std::string_view(a.data(), a.len()), std::string_view(b.data(), b.len()), unlimited);
+    }
+
+    usize edit_distance(const str& a, const str& b, const usize max) {
+        return edit_distance(std::string_view(a.data(), a.len()), std::string_view(b.data(), b.len()), max);
+    }
+
+
+
+    //batch scoring, a short query is run against lane_count candidates at once
+
+#ifdef AUSTINUTILS_AVX2
+    static constexpr usize lane_count = 4;
+#else
+    static constexpr usize lane_count = 2;
+#endif
+
+    static void scoreLanes(const u64* peq, const usize m, const str* lanes[lane_count], usize out[lane_count], const usize max) {
+        const u64 last = 1ULL << (m-1);
+        usize longest = 0;
+        for (usize l = 0; l < lane_count; l++) {
+            if (lanes[l]) longest = std::max(longest, lanes[l]->len());
+        }
+
+#ifdef AUSTINUTILS_AVX2
+        __m256i pv = _mm256_set1_epi64x(-1);
+        __m256i mv = _mm256_setzero_si256();
+        __m256i score = _mm256_set1_epi64x(cast(m, i64));
+        const __m256i last_v = _mm256_set1_epi64x(cast(last, i64));
+        const __m256i one = _mm256_set1_epi64x(1);
+        const __m256i zero = _mm256_setzero_si256();
+
+        for (usize j = 0; j < longest; j++) {
+            alignas(32) u64 eq_lanes[lane_count];
+            alignas(32) i64 active_lanes[lane_count];
+            for (usize l = 0; l < lane_count; l++) {
+                const bool active = lanes[l] && j < lanes[l]->len();
+                eq_lanes[l] = active ? peq[cast(lanes[l]->data()[j], u8)] : 0;
+                active_lanes[l] = active ? -1 : 0;
+            }
+            const __m256i eq = _mm256_load_si256(reinterpret_cast<const __m256i*>(eq_lanes));
+            const __m256i active = _mm256_load_si256(reinterpret_cast<const __m256i*>(active_lanes));
+
+            const __m256i xv = _mm256_or_si256(eq, mv);
+            const __m256i eq_pv = _mm256_and_si256(eq, pv);
+            const __m256i xh = _mm256_or_si256(_mm256_xor_si256(_mm256_add_epi64(eq_pv, pv), pv), eq);
+            __m256i ph = _mm256_or_si256(mv, _mm256_andnot_si256(_mm256_or_si256(xh, pv), _mm256_set1_epi64x(-1)));
+            __m256i mh = _mm256_and_si256(pv, xh);
+
+            //a lane that ran out of text keeps its score
+            const __m256i inc = _mm256_andnot_si256(_mm256_cmpeq_epi64(_mm256_and_si256(ph, last_v), zero), active);
+            const __m256i dec = _mm256_andnot_si256(_mm256_cmpeq_epi64(_mm256_and_si256(mh, last_v), zero), active);
+            score = _mm256_add_epi64(_mm256_sub_epi64(score, inc), dec);
+
+            ph = _mm256_or_si256(_mm256_slli_epi64(ph, 1), one);
+            mh = _mm256_slli_epi64(mh, 1);
+            pv = _mm256_or_si256(mh, _mm256_andnot_si256(_mm256_or_si256(xv, ph), _mm256_set1_epi64x(-1)));
+            mv = _mm256_and_si256(ph, xv);
+        }
+
+        alignas(32) u64 scores[lane_count];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(scores), score);
+#else
+        //plain lane arrays, laid out so the compiler can keep them in vector registers
+        u64 pv[lane_count], mv[lane_count], scores[lane_count];
+        for (usize l = 0; l < lane_count; l++) {
+            pv[l] = ~0ULL;
+            mv[l] = 0;
+            scores[l] = m;
+        }
+
+        for (usize j = 0; j < longest; j++) {
+            u64 eq[lane_count], active[lane_count];
+            for (usize l = 0; l < lane_count; l++) {
+                const bool on = lanes[l] && j < lanes[l]->len();
+                eq[l] = on ? peq[cast(lanes[l]->data()[j], u8)] : 0;
+                active[l] = on;
+            }
+            for (usize l = 0; l < lane_count; l++) {
+                const u64 xv = eq[l] | mv[l];
+                const u64 xh = (((eq[l] & pv[l]) + pv[l]) ^ pv[l]) | eq[l];
+                u64 ph = mv[l] | ~(xh | pv[l]);
+                u64 mh = pv[l] & xh;
+                scores[l] += active[l] & ((ph & last) != 0);
+                scores[l] -= active[l] & ((mh & last) != 0);
+                ph = (ph << 1) | 1;
+                mh <<= 1;
+                pv[l] = mh | ~(xv | ph);
+                mv[l] = ph & xv;
+            }
+        }
+#endif
+
+        for (usize l = 0; l < lane_count; l++) {
+            out[l] = std::min<usize>(scores[l], distanceBound(max));
+        }
+    }
+
+    std::vector<usize> edit_distances(const str& query, const std::vector<str>& candidates, const usize max, usize threads) {
+        std::vector<usize> ret(candidates.size());
+        if (candidates.empty()) return ret;
+
+        const std::string_view q(query.data(), query.len());
+        const usize m = q.size();
+        const bool lanes = m > 0 && m <= 64;
+
+        //grouping candidates of similar length keeps the lanes busy for the same number of steps
+        std::vector<usize> order(candidates.size());
+        std::iota(order.begin(), order.end(), 0);
+        if (lanes) {
+            std::sort(order.begin(), order.end(), [&](const usize a, const usize b) {
+                return candidates[a].len() < candidates[b].len();
+            });
+        }
+
+        u64 peq[256] = {};
+        for (usize i = 0; i < m && lanes; i++) peq[cast(q[i], u8)] |= 1ULL << i;
+
+        const auto work = [&](const usize begin, const usize end) {
+            usize i = begin;
+            if (lanes) {
+                for (; i + lane_count <= end; i += lane_count) {
+                    const str* group[lane_count];
+                    usize out[lane_count];
+                    for (usize l = 0; l < lane_count; l++) group[l] = &candidates[order[i+l]];
+                    scoreLanes(peq, m, group, out, max);
+                    for (usize l = 0; l < lane_count; l++) ret[order[i+l]] = out[l];
+                }
+            }
+            for (; i < end; i++) {
+                const str& c = candidates[order[i]];
+                ret[order[i]] = edit_distance(q, std::string_view(c.data(), c.len()), max);
+            }
+        };
+
+        threadpool& pool = threadpool::global();
+        if (threads == 0) threads = pool.size() + 1;
+        //a chunk is only worth scheduling for a decent amount of work, and each one gets whole lane groups
+        threads = std::min(threads, std::max<usize>(1, candidates.size() / 256));
+        const usize per = (candidates.size() / threads + lane_count - 1) / lane_count * lane_count;
+        pool.parallel_for(threads, [&](const usize t) {
+            const usize begin = std::min(t * per, candidates.size());
+            const usize end = t == threads-1 ? candidates.size() : std::min(begin + per, candidates.size());
+            work(begin, end);
+        });
+
+        return ret;
+    }
+
+    usize closest_match(const str& query, const std::vector<str>& candidates, const usize max, const usize threads) {
+        const std::vector<usize> scores = edit_distances(query, candidates, max, threads);
+        usize best = str::npos;
+        for (usize i = 0; i < scores.size(); i++) {
+            if (scores[i] <= max && (best == str::npos || scores[i] < scores[best])) best = i;
+        }
+        return best;
+    }
+}
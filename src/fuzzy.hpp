@@ -0,0 +1,38 @@
+#ifndef FUZZY_HPP
+#define FUZZY_HPP
+
+#include <string_view>
+#include <vector>
+#include "misc.hpp"
+#include "str.hpp"
+
+#define AUSTINUTILS __declspec(dllexport)
+
+//typo tolerant matching using myers' bit-vector edit distance, 64 rows of the dp matrix are computed per machine word
+
+namespace AustinUtils {
+
+    //returns the levenshtein distance between a and b
+    NODISCARD extern AUSTINUTILS usize edit_distance(std::string_view a, std::string_view b);
+
+    NODISCARD extern AUSTINUTILS usize edit_distance(const str& a, const str& b);
+
+    //returns the levenshtein distance between a and b if it is <= max, otherwise returns max+1 as soon as that is certain
+    NODISCARD extern AUSTINUTILS usize edit_distance(std::string_view a, std::string_view b, usize max);
+
+    NODISCARD extern AUSTINUTILS usize edit_distance(const str& a, const str& b, usize max);
+
+    /*
+     * scores query against every candidate, distances over max are reported as max+1
+     * short queries are scored against several candidates at once in simd lanes,
+     * and the candidates are split into threads chunks run on the global thread pool (0 means one per pool thread)
+     */
+    NODISCARD extern AUSTINUTILS std::vector<usize> edit_distances(const str& query, const std::vector<str>& candidates,
+                                                                   usize max = str::npos, usize threads = 0);
+
+    //returns the index of the candidate closest to query, or str::npos if none are within max
+    NODISCARD extern AUSTINUTILS usize closest_match(const str& query, const std::vector<str>& candidates,
+                                                     usize max = str::npos, usize threads = 0);
+}
+
+#endif
@@ -0,0 +1,347 @@
+#ifndef INPLACESTR_HPP
+#define INPLACESTR_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdarg>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include "Error.hpp"
+#include "misc.hpp"
+#include "str.hpp"
+
+//a fixed capacity string stored entirely inline, it never touches the allocator and is trivially copyable
+
+namespace AustinUtils {
+
+    enum INPLACE_OVERFLOW {
+        INPLACE_THROW,//throws an AustinUtils::Exception when an operation does not fit
+        INPLACE_TRUNCATE//keeps as much as fits and drops the rest
+    };
+
+    template<usize N, INPLACE_OVERFLOW policy = INPLACE_THROW>
+    class inplace_str {
+        static_assert(N > 0, "inplace_str needs a capacity of at least 1");
+
+        using length_type = std::conditional_t<N <= T_MAX(u8), u8, std::conditional_t<N <= T_MAX(u16), u16, usize>>;
+
+        char buffer[N+1];
+        length_type length;
+
+        //returns how many of n chars can be written, applying the overflow policy
+        usize fit(const usize n) const {
+            if (n <= N - length) return n;
+            if constexpr (policy == INPLACE_THROW) {
+                throw Exception("inplace_str<", N, "> overflow, cannot fit ", n, " more chars into ", N - length, " free");
+            }
+            return N - length;
+        }
+
+        //formats x in fixed notation straight into the free space, returns false and leaves the string untouched if it does not fit
+        template<FloatingPoint T>
+        bool write_fixed(const T x, const usize precision) {
+            const std::to_chars_result r = std::to_chars(buffer + length, buffer + N, x, std::chars_format::fixed, cast(precision, int));
+            if (r.ec != std::errc()) {
+                //to_chars may have scribbled over the free space, only the terminator matters
+                buffer[length] = '\0';
+                return false;
+            }
+            length = cast(r.ptr - buffer, length_type);
+            buffer[length] = '\0';
+            return true;
+        }
+
+    public:
+
+        static constexpr usize npos = str::npos;
+
+        using value_type = char;
+        using reference = char&;
+        using const_reference = const char&;
+
+        inplace_str() : length(0) {
+            buffer[0] = '\0';
+        }
+
+        inplace_str(const char* c_str) : inplace_str() {
+            append(c_str);
+        }
+
+        inplace_str(const char* c_str, const usize n) : inplace_str() {
+            append(std::string_view(c_str, n));
+        }
+
+        inplace_str(const std::string_view s) : inplace_str() {
+            append(s);
+        }
+
+        inplace_str(const str& s) : inplace_str() {
+            append(s);
+        }
+
+        NODISCARD usize len() const {
+            return length;
+        }
+
+        NODISCARD static constexpr usize capacity() {
+            return N;
+        }
+
+        NODISCARD bool empty() const {
+            return length == 0;
+        }
+
+        NODISCARD bool full() const {
+            return length == N;
+        }
+
+        void clear() {
+            length = 0;
+            buffer[0] = '\0';
+        }
+
+        //returns the internal null-terminated buffer
+        NODISCARD const char* data() const {
+            return buffer;
+        }
+
+        NODISCARD char& at(const usize index) {
+            if (index >= length) throw std::out_of_range("Cannot access element at " + std::to_string(index));
+            return buffer[index];
+        }
+
+        NODISCARD const char& at(const usize index) const {
+            if (index >= length) throw std::out_of_range("Cannot access element at " + std::to_string(index));
+            return buffer[index];
+        }
+
+        NODISCARD char& operator [](const usize index) {
+            return at(index);
+        }
+
+        NODISCARD const char& operator [](const usize index) const {
+            return at(index);
+        }
+
+        char& back() {
+            if (length == 0) throw std::out_of_range("Cannot access element at the back of an empty string");
+            return buffer[length-1];
+        }
+
+        char& front() {
+            if (length == 0) throw std::out_of_range("Cannot access element at the front of an empty string");
+            return buffer[0];
+        }
+
+        inplace_str& pop_back() {
+            if (length == 0) return *this;
+            buffer[--length] = '\0';
+            return *this;
+        }
+
+        //appends as much of s as the overflow policy allows
+        void append(const std::string_view s) {
+            const usize n = fit(s.size());
+            std::memcpy(buffer + length, s.data(), n);
+            length += n;
+            buffer[length] = '\0';
+        }
+
+        void append(const char* s) {
+            append(std::string_view(s));
+        }
+
+        void append(const str& s) {
+            append(std::string_view(s.data(), s.len()));
+        }
+
+        template<usize M, INPLACE_OVERFLOW P>
+        void append(const inplace_str<M, P>& s) {
+            append(std::string_view(s));
+        }
+
+        void append(const char c) {
+            if (fit(1) == 1) {
+                buffer[length++] = c;
+                buffer[length] = '\0';
+            }
+        }
+
+        template<Integral T>
+        void append(const T x) {
+            char digits[24];
+            const std::to_chars_result r = std::to_chars(digits, digits + sizeof(digits), x);
+            append(std::string_view(digits, r.ptr - digits));
+        }
+
+        //infinities and nans come out as inf, -inf and nan
+        template<FloatingPoint T>
+        void append(const T x, const usize precision = 6) {
+            if (write_fixed(x, precision)) return;
+
+            //too long for the free space, so it is formatted aside and handed to the overflow policy
+            //the largest finite value has max_exponent10+1 digits before the point, and decimals past N could never be kept
+            const usize decimals = std::min(precision, N);
+            char digits[std::numeric_limits<T>::max_exponent10 + 3 + N];
+            const std::to_chars_result r = std::to_chars(digits, digits + sizeof(digits), x, std::chars_format::fixed, cast(decimals, int));
+            const usize needed = cast(r.ptr - digits, usize) + (std::isfinite(x) ? precision - decimals : 0);
+            append(std::string_view(digits, fit(needed)));
+        }
+
+        //appends s only if it fits entirely, returns false and leaves the string untouched otherwise
+        bool try_append(const std::string_view s) {
+            if (s.size() > N - length) return false;
+            std::memcpy(buffer + length, s.data(), s.size());
+            length += s.size();
+            buffer[length] = '\0';
+            return true;
+        }
+
+        bool try_append(const char c) {
+            return try_append(std::string_view(&c, 1));
+        }
+
+        template<Arithmetic T>
+        bool try_append(const T x) {
+            //a float can be hundreds of chars long, so it is never cut down in a scratch string first
+            if constexpr (FloatingPoint<T>) {
+                return write_fixed(x, 6);
+            } else {
+                inplace_str<64, INPLACE_TRUNCATE> digits;
+                digits.append(x);
+                return try_append(std::string_view(digits));
+            }
+        }
+
+        template<typename T>
+        inplace_str& operator +=(const T x) {
+            append(x);
+            return *this;
+        }
+
+        template<typename T>
+        inplace_str operator +(const T x) const {
+            inplace_str ret = *this;
+            ret.append(x);
+            return ret;
+        }
+
+        //finds the first occurrence of s inside the range
+        NODISCARD usize find(const std::string_view s, const usize begin = 0, usize end = npos) const {
+            end = std::min<usize>(end, length);
+            if (begin > end || s.size() > end - begin) return npos;
+            const usize pos = std::string_view(buffer + begin, end - begin).find(s);
+            return pos == std::string_view::npos ? npos : pos + begin;
+        }
+
+        //finds the last occurrence of s inside the range
+        NODISCARD usize rfind(const std::string_view s, const usize begin = 0, usize end = npos) const {
+            end = std::min<usize>(end, length);
+            if (begin > end || s.size() > end - begin) return npos;
+            const usize pos = std::string_view(buffer + begin, end - begin).rfind(s);
+            return pos == std::string_view::npos ? npos : pos + begin;
+        }
+
+        NODISCARD usize count(const std::string_view s) const {
+            if (s.empty()) return 0;
+            usize c = 0;
+            for (usize i = find(s); i != npos; i = find(s, i + s.size())) c++;
+            return c;
+        }
+
+        NODISCARD bool startswith(const std::string_view prefix) const {
+            return std::string_view(*this).starts_with(prefix);
+        }
+
+        NODISCARD bool endswith(const std::string_view suffix) const {
+            return std::string_view(*this).ends_with(suffix);
+        }
+
+        NODISCARD inplace_str substr(const usize start, const usize n = npos) const {
+            if (start > length) throw Exception("Cannot access elements at ", start);
+            return inplace_str(std::string_view(*this).substr(start, n));
+        }
+
+        NODISCARD i64 compare(const std::string_view s) const {
+            return std::string_view(*this).compare(s);
+        }
+
+        bool operator ==(const std::string_view other) const { return compare(other) == 0; }
+        bool operator !=(const std::string_view other) const { return compare(other) != 0; }
+        bool operator <(const std::string_view other) const { return compare(other) < 0; }
+        bool operator <=(const std::string_view other) const { return compare(other) <= 0; }
+        bool operator >(const std::string_view other) const { return compare(other) > 0; }
+        bool operator >=(const std::string_view other) const { return compare(other) >= 0; }
+
+        /*
+         * formats using this string as the c-style format, the same way str::format does
+         * the result goes through the overflow policy like any append
+         */
+        NODISCARD inplace_str format(...) const {
+            inplace_str ret;
+            va_list vl;
+            va_start(vl, this);
+            const int needed = vsnprintf(ret.buffer, N+1, buffer, vl);
+            va_end(vl);
+
+            if (needed < 0) throw Exception("Error formatting string \"", buffer, "\"");
+            if (cast(needed, usize) > N) {
+                if constexpr (policy == INPLACE_THROW) {
+                    throw Exception("inplace_str<", N, "> overflow, formatting needs ", needed, " chars");
+                }
+                ret.length = N;
+            } else {
+                ret.length = cast(needed, length_type);
+            }
+            return ret;
+        }
+
+        operator std::string_view() const {
+            return {buffer, length};
+        }
+
+        //copies the string into a heap str
+        NODISCARD str toStr() const {
+            return {buffer, length};
+        }
+
+        friend std::ostream& operator <<(std::ostream& os, const inplace_str& self) {
+            os.write(self.buffer, self.length);
+            return os;
+        }
+
+        char* begin() {
+            return buffer;
+        }
+
+        char* end() {
+            return buffer + length;
+        }
+
+        NODISCARD const char* begin() const {
+            return buffer;
+        }
+
+        NODISCARD const char* end() const {
+            return buffer + length;
+        }
+    };
+}
+
+template<AustinUtils::usize N, AustinUtils::INPLACE_OVERFLOW policy>
+struct std::hash<AustinUtils::inplace_str<N, policy>> {
+    AustinUtils::usize operator()(const AustinUtils::inplace_str<N, policy>& s) const noexcept {
+        //the same hash as str, so both can be looked up interchangeably
+        AustinUtils::usize hash = 5381;
+        for (const char& c: s) {
+            hash = ((hash << 5) + hash) + c;
+        }
+
+        return hash;
+    }
+};
+
+#endif
@@ -0,0 +1,395 @@
+#include "json.hpp"
+
+#include <bit>
+#include <charconv>
+
+#include "Error.hpp"
+
+#ifdef AUSTINUTILS_SSE2
+#include <emmintrin.h>
+#endif
+
+
+namespace AustinUtils {
+
+    static bool isJsonWhitespace(const char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    static bool isJsonDelimiter(const char c) {
+        return isJsonWhitespace(c) || c == ',' || c == '}' || c == ']' || c == ':';
+    }
+
+#ifdef AUSTINUTILS_SSE2
+    static u64 matchMask(const __m128i chunks[4], const char c) {
+        const __m128i needle = _mm_set1_epi8(c);
+        u64 mask = 0;
+        for (usize i = 0; i < 4; i++) {
+            mask |= cast(cast(_mm_movemask_epi8(_mm_cmpeq_epi8(chunks[i], needle)), u16), u64) << (i*16);
+        }
+        return mask;
+    }
+#endif
+
+    json_index::json_index(const std::string_view document) {
+        build(document);
+    }
+
+    json_index::json_index(const str &document) {
+        build(std::string_view(document.data(), document.len()));
+    }
+
+    void json_index::index_block(const char *block, const usize base, u64 &escape_carry, u64 &string_carry, u64 &scalar_carry) {
+        u64 backslash = 0, quote = 0, op = 0, ws = 0;
+
+#ifdef AUSTINUTILS_SSE2
+        __m128i chunks[4];
+        for (usize i = 0; i < 4; i++) {
+            chunks[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i*16));
+        }
+        backslash = matchMask(chunks, '\\');
+        quote = matchMask(chunks, '"');
+        op = matchMask(chunks, '{') | matchMask(chunks, '}') | matchMask(chunks, '[') | matchMask(chunks, ']')
+           | matchMask(chunks, ':') | matchMask(chunks, ',');
+        ws = matchMask(chunks, ' ') | matchMask(chunks, '\t') | matchMask(chunks, '\n') | matchMask(chunks, '\r');
+#else
+        for (usize i = 0; i < 64; i++) {
+            const u64 bit = 1ULL << i;
+            switch (block[i]) {
+                case '\\': backslash |= bit; break;
+                case '"': quote |= bit; break;
+                case '{': case '}': case '[': case ']': case ':': case ',': op |= bit; break;
+                case ' ': case '\t': case '\n': case '\r': ws |= bit; break;
+                default: break;
+            }
+        }
+#endif
+
+        //work out which chars are escaped, backslashes are rare so walking them is cheaper than the branchless version
+        u64 escaped = 0;
+        if (escape_carry) {
+            escaped = 1;
+            backslash &= ~1ULL;
+        }
+        escape_carry = 0;
+        while (backslash) {
+            const int i = std::countr_zero(backslash);
+            if (i == 63) {
+                escape_carry = 1;
+                break;
+            }
+            escaped |= 1ULL << (i+1);
+            backslash &= ~((4ULL << i) - 1);
+        }
+
+        //a prefix xor over the real quotes marks everything inside a string, including the opening quote
+        quote &= ~escaped;
+        u64 inside = quote;
+        inside ^= inside << 1;
+        inside ^= inside << 2;
+        inside ^= inside << 4;
+        inside ^= inside << 8;
+        inside ^= inside << 16;
+        inside ^= inside << 32;
+        inside ^= string_carry;
+        string_carry = cast(cast(inside, i64) >> 63, u64);
+
+        const u64 scalar = ~(op | ws | quote) & ~inside;
+        const u64 scalar_starts = scalar & ~((scalar << 1) | scalar_carry);
+        scalar_carry = scalar >> 63;
+
+        u64 bits = (op & ~inside) | (quote & inside) | scalar_starts;
+        while (bits) {
+            positions.push_back(cast(base + std::countr_zero(bits), u32));
+            bits &= bits - 1;
+        }
+    }
+
+    void json_index::build(const std::string_view document) {
+        if (document.size() > T_MAX(u32)) throw Exception("Cannot index a JSON document larger than 4GB");
+        doc = document.data();
+        length = document.size();
+        positions.clear();
+        positions.reserve(length/8 + 16);
+
+        u64 escape_carry = 0, string_carry = 0, scalar_carry = 0;
+        usize base = 0;
+        for (; base + 64 <= length; base += 64) {
+            index_block(doc + base, base, escape_carry, string_carry, scalar_carry);
+        }
+        if (base < length) {
+            //pad the tail with whitespace so the block routine never reads past the document
+            char tail[64];
+            std::memset(tail, ' ', 64);
+            std::memcpy(tail, doc + base, length - base);
+            index_block(tail, base, escape_carry, string_carry, scalar_carry);
+        }
+
+        if (string_carry) throw Exception("Unterminated string in JSON document");
+    }
+
+    usize json_index::size() const {
+        return positions.size();
+    }
+
+    json_value json_index::root() const {
+        if (positions.empty()) throw Exception("Cannot read an empty JSON document");
+        return {this, 0};
+    }
+
+
+
+    char json_value::first() const {
+        return index->doc[index->positions[pos]];
+    }
+
+    usize json_value::skip() const {
+        const char c = first();
+        if (c != '{' && c != '[') return pos+1;
+
+        usize depth = 0;
+        for (usize p = pos; p < index->positions.size(); p++) {
+            switch (index->doc[index->positions[p]]) {
+                case '{': case '[':
+                    depth++;
+                    break;
+                case '}': case ']':
+                    if (--depth == 0) return p+1;
+                    break;
+                default:
+                    break;
+            }
+        }
+        throw Exception("Unterminated JSON ", c == '{' ? "object":"array");
+    }
+
+    JSON_TYPE json_value::type() const {
+        switch (first()) {
+            case '{': return JSON_OBJECT;
+            case '[': return JSON_ARRAY;
+            case '"': return JSON_STRING;
+            case 't': case 'f': return JSON_BOOL;
+            case 'n': return JSON_NULL;
+            default: return JSON_NUMBER;
+        }
+    }
+
+    bool json_value::find(const std::string_view key, json_value &out) const {
+        if (first() != '{') throw Exception("Cannot look up key \"", key, "\" in a JSON value that is not an object");
+
+        const std::vector<u32>& positions = index->positions;
+        usize p = pos+1;
+        if (p < positions.size() && index->doc[positions[p]] == '}') return false;
+
+        while (p + 2 < positions.size()) {
+            const json_value name(index, p);
+            if (name.first() != '"' || index->doc[positions[p+1]] != ':') throw Exception("Malformed JSON object member");
+
+            const json_value value(index, p+2);
+            if (name.get_view() == key) {
+                out = value;
+                return true;
+            }
+
+            p = value.skip();
+            if (p >= positions.size()) break;
+            const char c = index->doc[positions[p]];
+            if (c == '}') return false;
+            if (c != ',') throw Exception("Expected ',' or '}' in JSON object");
+            p++;
+        }
+        throw Exception("Unterminated JSON object");
+    }
+
+    json_value json_value::operator[](const std::string_view key) const {
+        json_value ret;
+        if (!find(key, ret)) throw Exception("No key \"", key, "\" in JSON object");
+        return ret;
+    }
+
+    json_value json_value::at(const usize i) const {
+        if (first() != '[') throw Exception("Cannot index a JSON value that is not an array");
+
+        const std::vector<u32>& positions = index->positions;
+        usize p = pos+1;
+        if (p < positions.size() && index->doc[positions[p]] == ']') throw Exception("Cannot access element at index ", i);
+
+        for (usize k = 0; p < positions.size(); k++) {
+            const json_value element(index, p);
+            if (k == i) return element;
+
+            p = element.skip();
+            if (p >= positions.size()) break;
+            const char c = index->doc[positions[p]];
+            if (c == ']') throw Exception("Cannot access element at index ", i);
+            if (c != ',') throw Exception("Expected ',' or ']' in JSON array");
+            p++;
+        }
+        throw Exception("Unterminated JSON array");
+    }
+
+    usize json_value::count() const {
+        const char open = first();
+        if (open != '{' && open != '[') throw Exception("Cannot count the elements of a JSON scalar");
+        const char close = open == '{' ? '}':']';
+
+        const std::vector<u32>& positions = index->positions;
+        usize p = pos+1;
+        if (p < positions.size() && index->doc[positions[p]] == close) return 0;
+
+        usize c = 0;
+        while (p < positions.size()) {
+            c++;
+            //members are key, ':' and then the value
+            p = json_value(index, open == '{' ? p+2:p).skip();
+            if (p >= positions.size()) break;
+            if (index->doc[positions[p]] == close) return c;
+            p++;
+        }
+        throw Exception("Unterminated JSON value");
+    }
+
+    std::string_view json_value::get_view() const {
+        if (first() != '"') throw Exception("JSON value is not a string");
+
+        const usize start = index->positions[pos]+1;
+        usize end = pos+1 < index->positions.size() ? index->positions[pos+1]:index->length;
+        //the closing quote is the last quote before the next structural char
+        while (end > start && index->doc[end-1] != '"') end--;
+        if (end <= start) throw Exception("Unterminated JSON string");
+
+        return {index->doc + start, end-1-start};
+    }
+
+    static void appendUtf8(str& s, const u32 cp) {
+        if (cp < 0x80) {
+            s.append(cast(cp, char));
+        } else if (cp < 0x800) {
+            s.append(cast(0xC0 | (cp >> 6), char));
+            s.append(cast(0x80 | (cp & 0x3F), char));
+        } else if (cp < 0x10000) {
+            s.append(cast(0xE0 | (cp >> 12), char));
+            s.append(cast(0x80 | ((cp >> 6) & 0x3F), char));
+            s.append(cast(0x80 | (cp & 0x3F), char));
+        } else {
+            s.append(cast(0xF0 | (cp >> 18), char));
+            s.append(cast(0x80 | ((cp >> 12) & 0x3F), char));
+            s.append(cast(0x80 | ((cp >> 6) & 0x3F), char));
+            s.append(cast(0x80 | (cp & 0x3F), char));
+        }
+    }
+
+    static u32 parseHex4(const std::string_view v, const usize i) {
+        if (i + 4 > v.size()) throw Exception("Truncated \\u escape in JSON string");
+        u32 cp = 0;
+        for (usize j = i; j < i+4; j++) {
+            const char c = v[j];
+            cp <<= 4;
+            if (c >= '0' && c <= '9') cp |= c - '0';
+            else if (c >= 'a' && c <= 'f') cp |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') cp |= c - 'A' + 10;
+            else throw Exception("Invalid \\u escape in JSON string");
+        }
+        return cp;
+    }
+
+    str json_value::get_str() const {
+        const std::string_view v = get_view();
+        str ret;
+        ret.resize(v.size()+1);
+
+        for (usize i = 0; i < v.size(); i++) {
+            if (v[i] != '\\') {
+                ret.append(v[i]);
+                continue;
+            }
+            if (++i >= v.size()) throw Exception("Truncated escape in JSON string");
+            switch (v[i]) {
+                case '"': ret.append('"'); break;
+                case '\\': ret.append('\\'); break;
+                case '/': ret.append('/'); break;
+                case 'b': ret.append('\b'); break;
+                case 'f': ret.append('\f'); break;
+                case 'n': ret.append('\n'); break;
+                case 'r': ret.append('\r'); break;
+                case 't': ret.append('\t'); break;
+                case 'u': {
+                    u32 cp = parseHex4(v, i+1);
+                    i += 4;
+                    //surrogate pairs encode everything past the basic multilingual plane
+                    if (cp >= 0xD800 && cp <= 0xDBFF && i+6 < v.size() && v.substr(i+1, 2) == "\\u") {
+                        const u32 low = parseHex4(v, i+3);
+                        if (low >= 0xDC00 && low <= 0xDFFF) {
+                            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                            i += 6;
+                        }
+                    }
+                    appendUtf8(ret, cp);
+                    break;
+                }
+                default:
+                    throw Exception("Invalid escape '\\", v[i], "' in JSON string");
+            }
+        }
+
+        return ret;
+    }
+
+    std::string_view json_value::raw() const {
+        const usize start = index->positions[pos];
+        switch (first()) {
+            case '{': case '[':
+                return {index->doc + start, index->positions[skip()-1]+1-start};
+            case '"': {
+                const std::string_view v = get_view();
+                return {index->doc + start, v.size()+2};
+            }
+            default: {
+                usize end = start;
+                while (end < index->length && !isJsonDelimiter(index->doc[end])) end++;
+                return {index->doc + start, end-start};
+            }
+        }
+    }
+
+    std::string_view json_value::number_token() const {
+        if (type() != JSON_NUMBER) throw Exception("JSON value is not a number");
+        return raw();
+    }
+
+    //parses all of token as a T, from_chars rounds a double correctly once and reports values that do not fit instead of clamping them
+    template<typename T>
+    static T parseNumber(const std::string_view token, const char* what) {
+        T x{};
+        const std::from_chars_result r = std::from_chars(token.data(), token.data() + token.size(), x);
+        if (r.ec == std::errc::result_out_of_range) throw Exception("JSON number ", token, " does not fit in ", what);
+        if (r.ec != std::errc() || r.ptr != token.data() + token.size()) throw Exception("JSON number ", token, " is not a valid ", what);
+        return x;
+    }
+
+    i64 json_value::get_i64() const {
+        return parseNumber<i64>(number_token(), "an i64");
+    }
+
+    u64 json_value::get_u64() const {
+        const std::string_view token = number_token();
+        if (token.starts_with('-')) throw Exception("JSON number ", token, " is negative");
+        return parseNumber<u64>(token, "a u64");
+    }
+
+    double json_value::get_double() const {
+        return parseNumber<double>(number_token(), "a double");
+    }
+
+    bool json_value::get_bool() const {
+        const std::string_view token = raw();
+        if (token == "true") return true;
+        if (token == "false") return false;
+        throw Exception("JSON value \"", token, "\" is not a boolean");
+    }
+
+    bool json_value::is_null() const {
+        return raw() == "null";
+    }
+
+}
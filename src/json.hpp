@@ -0,0 +1,113 @@
+#ifndef JSON_HPP
+#define JSON_HPP
+
+#include <string_view>
+#include <vector>
+#include "misc.hpp"
+#include "str.hpp"
+
+#define AUSTINUTILS __declspec(dllexport)
+
+//a two stage json tokenizer, the first stage builds an index of every structural character in one vectorized pass,
+//the second stage walks that index on demand, so pulling a few fields never builds a dom or allocates per value
+
+namespace AustinUtils {
+
+    enum JSON_TYPE {
+        JSON_OBJECT,
+        JSON_ARRAY,
+        JSON_STRING,
+        JSON_NUMBER,
+        JSON_BOOL,
+        JSON_NULL
+    };
+
+    class json_value;
+
+    class AUSTINUTILS json_index {
+        friend class json_value;
+
+        const char* doc = null;
+        usize length = 0;
+        //offsets of every structural char, every opening quote and the start of every scalar
+        std::vector<u32> positions;
+
+        void index_block(const char* block, usize base, u64& escape_carry, u64& string_carry, u64& scalar_carry);
+
+    public:
+
+        json_index() = default;
+
+        //indexes the document, the document must outlive the index
+        explicit json_index(std::string_view document);
+
+        explicit json_index(const str& document);
+
+        //rebuilds the index for a new document, reusing the index memory
+        void build(std::string_view document);
+
+        //returns the number of indexed positions
+        NODISCARD usize size() const;
+
+        //returns the root value of the document
+        NODISCARD json_value root() const;
+    };
+
+    class AUSTINUTILS json_value {
+        friend class json_index;
+
+        const json_index* index = null;
+        usize pos = 0;
+
+        json_value(const json_index* index, usize pos) : index(index), pos(pos) {}
+
+        NODISCARD char first() const;
+
+        //returns the index position just past this value
+        NODISCARD usize skip() const;
+
+        //the raw text of a number, throws if it is not a number
+        NODISCARD std::string_view number_token() const;
+
+    public:
+
+        json_value() = default;
+
+        NODISCARD JSON_TYPE type() const;
+
+        //finds the value of key inside this object, returns false if there is no such key
+        bool find(std::string_view key, json_value& out) const;
+
+        //returns the value of key inside this object, throws if there is no such key
+        NODISCARD json_value operator [](std::string_view key) const;
+
+        //returns the element at i inside this array, throws if i is out of range
+        NODISCARD json_value at(usize i) const;
+
+        //returns the number of elements/members inside an array/object
+        NODISCARD usize count() const;
+
+        //returns a view of the raw string contents between the quotes, escape sequences are left as-is
+        NODISCARD std::string_view get_view() const;
+
+        //returns the string with escape sequences decoded, this allocates
+        NODISCARD str get_str() const;
+
+        //the number as an integer, throws if it has a fraction or exponent or does not fit
+        NODISCARD i64 get_i64() const;
+
+        NODISCARD u64 get_u64() const;
+
+        //the number rounded once to the nearest double, throws if it is outside the range of a double
+        NODISCARD double get_double() const;
+
+        NODISCARD bool get_bool() const;
+
+        NODISCARD bool is_null() const;
+
+        //returns a view of the raw json text of this value
+        NODISCARD std::string_view raw() const;
+    };
+}
+
+#endif
@@ -0,0 +1,396 @@
+#include "logformat.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <ctime>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define AUSTINUTILS_HAS_TSC
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define AUSTINUTILS_HAS_TSC
+#endif
+#ifdef AUSTINUTILS_SSE2
+#include <emmintrin.h>
+#endif
+
+
+namespace AustinUtils {
+
+    //deeper nesting than this gets a fresh buffer each time
+    static constexpr usize line_pool_size = 4;
+
+    struct log_thread_buffers {
+        std::string lines[line_pool_size];
+        usize depth = 0;
+        std::ostringstream stream;
+        bool stream_busy = false;
+    };
+
+    static thread_local log_thread_buffers buffers;
+
+    log_line::log_line() {
+        borrowed = buffers.depth < line_pool_size;
+        if (borrowed) {
+            buffer = &buffers.lines[buffers.depth++];
+            buffer->clear();
+        } else {
+            buffer = new std::string();
+        }
+    }
+
+    log_line::~log_line() {
+        if (borrowed) buffers.depth--;
+        else delete buffer;
+    }
+
+    log_stream::log_stream() {
+        borrowed = !buffers.stream_busy;
+        if (borrowed) {
+            buffers.stream_busy = true;
+            std::ostringstream& s = buffers.stream;
+            //an operator<< may have left flags behind last time
+            s.flags(std::ios_base::skipws | std::ios_base::dec);
+            s.precision(6);
+            s.width(0);
+            s.fill(' ');
+            //seeking a stream that was never written to fails, it is at 0 either way
+            s.seekp(0);
+            s.clear();
+            stream = &s;
+        } else {
+            stream = new std::ostringstream();
+        }
+    }
+
+    log_stream::~log_stream() {
+        if (borrowed) buffers.stream_busy = false;
+        else delete stream;
+    }
+
+    std::string_view log_stream::view() const {
+        const auto& s = static_cast<const std::ostringstream&>(*stream);
+        const auto end = const_cast<std::ostringstream&>(s).tellp();
+        return s.view().substr(0, end < 0 ? 0 : cast(end, usize));
+    }
+
+
+    static std::atomic<LOG_CLOCK> current_clock = LOG_CLOCK_REALTIME;
+
+    static u64 realtime_now() {
+#ifdef _WIN32
+        return cast(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count(), u64);
+#else
+        timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        return cast(ts.tv_sec, u64) * 1000000000 + ts.tv_nsec;
+#endif
+    }
+
+    static u64 coarse_now() {
+#ifdef CLOCK_REALTIME_COARSE
+        timespec ts;
+        clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+        return cast(ts.tv_sec, u64) * 1000000000 + ts.tv_nsec;
+#else
+        return realtime_now();
+#endif
+    }
+
+    //the length of a tick, measured once
+    struct tsc_calibration {
+        bool usable = false;
+        double ns_per_tick = 0;
+        u64 ticks_per_second = 0;
+    };
+
+    /*
+     * where the calling thread last pinned the counter to the wall clock, it is pinned again about once a second,
+     * so an error in the tick length or the wall clock being adjusted never builds up past a second's worth
+     * the tick length is re-measured over that second, which is far more precise than the 20ms calibration
+     */
+    struct tsc_anchor {
+        u64 ticks = 0;
+        u64 time = 0;
+        double ns_per_tick = 0;
+    };
+
+#ifdef AUSTINUTILS_HAS_TSC
+    static bool invariant_tsc() {
+#ifdef _WIN32
+        int regs[4];
+        __cpuid(regs, 0x80000000);
+        if (cast(regs[0], u32) < 0x80000007) return false;
+        __cpuid(regs, 0x80000007);
+        return (regs[3] & (1 << 8)) != 0;
+#else
+        unsigned a, b, c, d;
+        if (__get_cpuid_max(0x80000000, null) < 0x80000007) return false;
+        if (!__get_cpuid(0x80000007, &a, &b, &c, &d)) return false;
+        return (d & (1 << 8)) != 0;
+#endif
+    }
+#endif
+
+    static const tsc_calibration& calibration() {
+        static const tsc_calibration calibrated = [] {
+            tsc_calibration c;
+#ifdef AUSTINUTILS_HAS_TSC
+            if (!invariant_tsc()) return c;
+            const u64 ticks0 = __rdtsc();
+            const u64 time0 = realtime_now();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            const u64 ticks1 = __rdtsc();
+            const u64 time1 = realtime_now();
+            if (ticks1 <= ticks0 || time1 <= time0) return c;
+            c.ns_per_tick = cast(time1 - time0, double) / cast(ticks1 - ticks0, double);
+            c.ticks_per_second = cast(1e9 / c.ns_per_tick, u64);
+            c.usable = true;
+#endif
+            return c;
+        }();
+        return calibrated;
+    }
+
+    LOG_CLOCK set_log_clock(const LOG_CLOCK clock) {
+        if (clock == LOG_CLOCK_TSC && !calibration().usable) return current_clock.load();
+        current_clock.store(clock);
+        return clock;
+    }
+
+    LOG_CLOCK log_clock() {
+        return current_clock.load(std::memory_order_relaxed);
+    }
+
+    u64 log_clock_now() {
+        switch (current_clock.load(std::memory_order_relaxed)) {
+            case LOG_CLOCK_COARSE:
+                return coarse_now();
+            case LOG_CLOCK_TSC: {
+#ifdef AUSTINUTILS_HAS_TSC
+                //only ever selected once calibrated
+                static thread_local tsc_anchor anchor;
+                const tsc_calibration& c = calibration();
+                const u64 ticks = __rdtsc();
+                //the first call on a thread starts at 0 ticks, and a counter behind the anchor wraps around, so both pin it
+                if (ticks - anchor.ticks >= c.ticks_per_second) {
+                    const u64 time = realtime_now();
+                    const double measured = cast(cast(time - anchor.time, i64), double) / cast(ticks - anchor.ticks, double);
+                    //a wall clock that was stepped in between says nothing about the tick length
+                    const bool plausible = anchor.ticks != 0 && measured > c.ns_per_tick * 0.99 && measured < c.ns_per_tick * 1.01;
+                    anchor.ns_per_tick = plausible ? measured : c.ns_per_tick;
+                    anchor.ticks = ticks;
+                    anchor.time = time;
+                    return time;
+                }
+                return anchor.time + cast(cast(ticks - anchor.ticks, double) * anchor.ns_per_tick, u64);
+#else
+                return realtime_now();
+#endif
+            }
+            default:
+                return realtime_now();
+        }
+    }
+
+    u64 log_thread_id() {
+        static thread_local const u64 id = [] {
+#if defined(_WIN32)
+            return cast(GetCurrentThreadId(), u64);
+#elif defined(__linux__)
+            return cast(syscall(SYS_gettid), u64);
+#else
+            return cast(std::hash<std::thread::id>()(std::this_thread::get_id()), u64);
+#endif
+        }();
+        return id;
+    }
+
+    //the "YYYY-MM-DD HH:MM:SS." part of the last second this thread formatted
+    struct log_date_cache {
+        u64 second = ~cast(0, u64);
+        char text[32];
+        usize size = 0;
+    };
+
+    static thread_local log_date_cache date_cache;
+
+    //date and time with microseconds, ISO 8601 with a T instead of the space for the structured encodings
+    static void append_time(std::string& out, const u64 time, const bool iso) {
+        const u64 second = time / 1000000000;
+        if (second != date_cache.second) {
+            const std::time_t t = cast(second, std::time_t);
+            std::tm local;
+#ifdef _WIN32
+            localtime_s(&local, &t);
+#else
+            localtime_r(&t, &local);
+#endif
+            date_cache.size = std::strftime(date_cache.text, sizeof(date_cache.text), "%Y-%m-%d %H:%M:%S.", &local);
+            date_cache.second = second;
+        }
+        char micros[6];
+        u64 us = time % 1000000000 / 1000;
+        for (int i = 5; i >= 0; i--) {
+            micros[i] = cast('0' + us % 10, char);
+            us /= 10;
+        }
+        const usize start = out.size();
+        out.append(date_cache.text, date_cache.size);
+        out.append(micros, sizeof(micros));
+        if (iso && date_cache.size > 10) out[start + 10] = 'T';
+    }
+
+    void log_append_fields(std::string& out, const u32 fields, const u64 time, const u64 thread, const LOG_ENCODING encoding) {
+        switch (encoding) {
+            case LOG_ENCODING_JSON:
+                if (fields & LOG_FIELD_TIME) {
+                    out.append("\"time\":\"");
+                    append_time(out, time, true);
+                    out.append("\",");
+                }
+                if (fields & LOG_FIELD_THREAD) {
+                    out.append("\"thread\":");
+                    log_append(out, thread);
+                    out.push_back(',');
+                }
+                return;
+            case LOG_ENCODING_LOGFMT:
+                if (fields & LOG_FIELD_TIME) {
+                    out.append("time=");
+                    append_time(out, time, true);
+                    out.push_back(' ');
+                }
+                if (fields & LOG_FIELD_THREAD) {
+                    out.append("thread=");
+                    log_append(out, thread);
+                    out.push_back(' ');
+                }
+                return;
+            default:
+                if (fields & LOG_FIELD_TIME) {
+                    out.push_back('[');
+                    append_time(out, time, false);
+                    out.push_back(']');
+                }
+                if (fields & LOG_FIELD_THREAD) {
+                    out.push_back('[');
+                    log_append(out, thread);
+                    out.push_back(']');
+                }
+        }
+    }
+
+    //true for the bytes that can not appear as they are inside a quoted JSON or logfmt string
+    static bool needs_escape(const u8 c) {
+        return c < 0x20 || c == '"' || c == '\\';
+    }
+
+    //the index of the first byte at or after i that needs escaping, or s.size()
+    static usize find_escape(const std::string_view s, usize i) {
+#ifdef AUSTINUTILS_SSE2
+        const __m128i space = _mm_set1_epi8(0x1F);
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        for (; i + 16 <= s.size(); i += 16) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s.data() + i));
+            //unsigned v <= 0x1F, as max(v, 0x1F) == 0x1F
+            const __m128i control = _mm_cmpeq_epi8(_mm_max_epu8(v, space), space);
+            const __m128i special = _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash));
+            const int mask = _mm_movemask_epi8(_mm_or_si128(control, special));
+            if (mask != 0) return i + std::countr_zero(cast(mask, u32));
+        }
+#endif
+        while (i < s.size() && !needs_escape(cast(s[i], u8))) i++;
+        return i;
+    }
+
+    void log_append_escaped(std::string& out, const LOG_ENCODING encoding, const std::string_view s) {
+        if (encoding == LOG_ENCODING_TEXT) {
+            out.append(s);
+            return;
+        }
+        usize start = 0;
+        loop {
+            const usize i = find_escape(s, start);
+            out.append(s.data() + start, i - start);
+            if (i == s.size()) return;
+            switch (const char c = s[i]) {
+                case '"':
+                    out.append("\\\"");
+                    break;
+                case '\\':
+                    out.append("\\\\");
+                    break;
+                case '\n':
+                    out.append("\\n");
+                    break;
+                case '\r':
+                    out.append("\\r");
+                    break;
+                case '\t':
+                    out.append("\\t");
+                    break;
+                default: {
+                    constexpr char digits[] = "0123456789abcdef";
+                    const char code[] = {'\\', 'u', '0', '0', digits[cast(c, u8) >> 4], digits[cast(c, u8) & 0xF]};
+                    out.append(code, sizeof(code));
+                }
+            }
+            start = i + 1;
+        }
+    }
+
+    //the chars logfmt can not have outside quotes
+    static bool logfmt_special(const char c) {
+        return cast(c, u8) <= ' ' || c == '=' || c == '"' || c == '\\';
+    }
+
+    void log_append_string(std::string& out, const LOG_ENCODING encoding, const std::string_view s) {
+        if (encoding != LOG_ENCODING_JSON) {
+            //logfmt only quotes values that would not parse otherwise
+            const bool plain = !s.empty() && std::none_of(s.begin(), s.end(), logfmt_special);
+            if (plain) {
+                out.append(s);
+                return;
+            }
+        }
+        out.push_back('"');
+        log_append_escaped(out, LOG_ENCODING_JSON, s);
+        out.push_back('"');
+    }
+
+    void log_append_key(std::string& out, const LOG_ENCODING encoding, const std::string_view key) {
+        if (encoding == LOG_ENCODING_JSON) {
+            out.push_back('"');
+            log_append_escaped(out, LOG_ENCODING_JSON, key);
+            out.push_back('"');
+            return;
+        }
+        //logfmt parsers do not take quoted keys, so what would break one becomes '_'
+        if (key.empty()) {
+            out.push_back('_');
+            return;
+        }
+        const usize start = out.size();
+        out.append(key);
+        for (usize i = start; i < out.size(); i++) {
+            if (logfmt_special(out[i])) out[i] = '_';
+        }
+    }
+}
@@ -0,0 +1,183 @@
+#ifndef LOGFORMAT_HPP
+#define LOGFORMAT_HPP
+
+#include <charconv>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "misc.hpp"
+#include "logsink.hpp"
+
+#define AUSTINUTILS __declspec(dllexport)
+
+//building log lines without a stringstream or a new std::string per call
+
+namespace AustinUtils {
+
+    /*
+     * a per-thread stream for the types log_append can not format itself, reset before every use
+     * if an operator<< logs while the stream is in use, the nested call gets a stream of its own
+     */
+    class AUSTINUTILS log_stream {
+        std::ostream* stream;
+        bool borrowed;
+
+    public:
+        log_stream();
+
+        log_stream(const log_stream&) = delete;
+
+        log_stream& operator =(const log_stream&) = delete;
+
+        ~log_stream();
+
+        std::ostream& get() {
+            return *stream;
+        }
+
+        //what has been written since the stream was handed out
+        NODISCARD std::string_view view() const;
+    };
+
+    //appends x the same way a default std::ostream would, the common types without going through a stream at all
+    template<typename T>
+    void log_append(std::string& out, const T& x) {
+        if constexpr (std::is_same_v<T, bool>) {
+            out.push_back(x ? '1' : '0');
+        } else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>) {
+            out.push_back(cast(x, char));
+        } else if constexpr (std::is_integral_v<T> || std::is_floating_point_v<T>) {
+            char buffer[64];
+            std::to_chars_result r;
+            if constexpr (std::is_floating_point_v<T>) r = std::to_chars(buffer, buffer + sizeof(buffer), x, std::chars_format::general, 6);
+            else r = std::to_chars(buffer, buffer + sizeof(buffer), x);
+            out.append(buffer, r.ptr);
+        } else if constexpr (std::is_pointer_v<T> && std::is_convertible_v<T, const char*>) {
+            //like std::ostream, a null char* is an error, write something readable instead
+            out.append(x == null ? "(null)" : x);
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view> && !std::is_pointer_v<T>) {
+            out.append(std::string_view(x));
+        } else {
+            log_stream stream;
+            stream.get() << x;
+            out.append(stream.view());
+        }
+    }
+
+    /*
+     * log_append for a wide logger's arguments, wide strings and chars are transcoded to UTF-8 in one pass, numbers and narrow strings
+     * are appended exactly as log_append does, anything else goes through a std::wostringstream
+     */
+    template<typename T>
+    void log_append_wide(std::string& out, const T& x) {
+        if constexpr (std::is_same_v<T, wchar_t>) {
+            append_utf8(out, std::wstring_view(&x, 1));
+        } else if constexpr (std::is_pointer_v<T> && std::is_convertible_v<T, const wchar_t*>) {
+            if (x == null) out.append("(null)");
+            else append_utf8(out, x);
+        } else if constexpr (std::is_convertible_v<const T&, std::wstring_view> && !std::is_pointer_v<T>) {
+            append_utf8(out, std::wstring_view(x));
+        } else if constexpr (std::is_arithmetic_v<T> || std::is_convertible_v<const T&, std::string_view> ||
+                             (std::is_pointer_v<T> && std::is_convertible_v<T, const char*>)) {
+            log_append(out, x);
+        } else {
+            std::wostringstream stream;
+            stream << x;
+            append_utf8(out, stream.view());
+        }
+    }
+
+    //how a logger lays out its records
+    enum LOG_ENCODING {
+        LOG_ENCODING_TEXT,//[LEVEL][name]: message key=value, the default
+        LOG_ENCODING_JSON,//{"level":"LEVEL","logger":"name","msg":"message","key":value}, one object per line
+        LOG_ENCODING_LOGFMT//level=LEVEL logger=name msg="message" key=value
+    };
+
+    //optional fields a logger puts in front of every line, combined with |
+    enum LOG_FIELD : u32 {
+        LOG_FIELD_NONE = 0,
+        LOG_FIELD_TIME = 1,//"[2026-01-31 23:59:59.123456]", local time
+        LOG_FIELD_THREAD = 2//"[12345]", the OS thread id
+    };
+
+    //where log timestamps come from
+    enum LOG_CLOCK {
+        LOG_CLOCK_REALTIME,//the precise wall clock, the default
+        LOG_CLOCK_COARSE,//CLOCK_REALTIME_COARSE, a few ms of resolution but cheaper, the precise clock where it does not exist
+        LOG_CLOCK_TSC//the cpu's timestamp counter, pinned to the wall clock again about once a second, needs an invariant TSC
+    };
+
+    /*
+     * picks the clock for every timestamp from now on and returns the one actually used
+     * asking for LOG_CLOCK_TSC the first time spends about 20ms calibrating it, without an invariant TSC the clock stays as it was
+     */
+    extern AUSTINUTILS LOG_CLOCK set_log_clock(LOG_CLOCK clock);
+
+    NODISCARD extern AUSTINUTILS LOG_CLOCK log_clock();
+
+    //nanoseconds since the unix epoch from the current clock
+    NODISCARD extern AUSTINUTILS u64 log_clock_now();
+
+    //the OS id of the calling thread, looked up once per thread
+    NODISCARD extern AUSTINUTILS u64 log_thread_id();
+
+    /*
+     * appends the fields asked for, time is from log_clock_now()
+     * the date and time down to the second are formatted once per second per thread, each line only renders the microseconds
+     */
+    extern AUSTINUTILS void log_append_fields(std::string& out, u32 fields, u64 time, u64 thread, LOG_ENCODING encoding = LOG_ENCODING_TEXT);
+
+    //appends s escaped for the inside of a JSON or logfmt string, as it is for LOG_ENCODING_TEXT, 16 bytes at a time with SSE2
+    extern AUSTINUTILS void log_append_escaped(std::string& out, LOG_ENCODING encoding, std::string_view s);
+
+    //appends s as a complete string value, JSON always quotes it, logfmt and text only when it contains a space, '=', '"' or a control char
+    extern AUSTINUTILS void log_append_string(std::string& out, LOG_ENCODING encoding, std::string_view s);
+
+    //appends a field name, quoted and escaped for JSON, for logfmt and text a space, '=', '"', '\\' or control char becomes '_'
+    extern AUSTINUTILS void log_append_key(std::string& out, LOG_ENCODING encoding, std::string_view key);
+
+    //the pieces around a structured record, between them go the fields, the logger's prefix, the message and the key value pairs
+    inline void log_open_record(std::string& out, const LOG_ENCODING encoding) {
+        if (encoding == LOG_ENCODING_JSON) out.push_back('{');
+    }
+
+    inline void log_open_message(std::string& out, const LOG_ENCODING encoding) {
+        out.append(encoding == LOG_ENCODING_JSON ? ",\"msg\":\"" : " msg=\"");
+    }
+
+    inline void log_close_message(std::string& out, LOG_ENCODING) {
+        out.push_back('"');
+    }
+
+    inline void log_close_record(std::string& out, const LOG_ENCODING encoding) {
+        out.append(encoding == LOG_ENCODING_JSON ? "}\n" : "\n");
+    }
+
+    /*
+     * a per-thread buffer log lines are built in, it keeps its capacity between calls so steady state logging never allocates
+     * if something logs while a line is being built (an operator<< that logs), the nested line gets the next buffer of a small pool
+     */
+    class AUSTINUTILS log_line {
+        std::string* buffer;
+        bool borrowed;
+
+    public:
+        log_line();
+
+        log_line(const log_line&) = delete;
+
+        log_line& operator =(const log_line&) = delete;
+
+        ~log_line();
+
+        //the buffer, empty when handed out
+        std::string& get() {
+            return *buffer;
+        }
+    };
+}
+
+#endif
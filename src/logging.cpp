@@ -1,81 +1,262 @@
-#include "logging.hpp"
-
-AUSTINUTILS std::string AustinUtils::LogTypeToString(const LOG_TYPE typ) {
-    switch (typ) {
-        case LOG_INFO:
-            return "INFO";
-        case LOG_WARN:
-            return "WARN";
-        case LOG_ERROR:
-            return "ERROR";
-        case LOG_DEBUG:
-            return "DEBUG";
-    }
-    return "LOG";
-}
-
-AUSTINUTILS std::wstring AustinUtils::LogTypeToWString(const LOG_TYPE typ) {
-    switch (typ) {
-        case AustinUtils::LOG_INFO:
-            return L"INFO";
-        case AustinUtils::LOG_WARN:
-            return L"WARN";
-        case AustinUtils::LOG_ERROR:
-            return L"ERROR";
-        case AustinUtils::LOG_DEBUG:
-            return L"DEBUG";
-    }
-    return L"LOG";
-}
-
-AustinUtils::logger::logger(const std::string& name) {
-    this->name = name;
-}
-
-void AustinUtils::logger::c_log(LOG_TYPE type, const char *fmt, ...) {
-    va_list args;
-    char buffer[1024];
-
-    va_start(args, fmt);
-    vsnprintf(buffer, 1024, fmt, args);
-    va_end(args);
-    if (type == LOG_ERROR) std::cerr << "[" << LogTypeToString(type) << "][" << name << "]: " << buffer << "\n";
-    if (type != LOG_ERROR) std::cout << "[" << LogTypeToString(type) << "][" << name << "]: " << buffer << "\n";
-
-}
-
-void AustinUtils::logger::c_log(LOG_TYPE type, const char* fmt, va_list args) {
-
-    char buffer[1024];
-
-
-    vsnprintf(buffer, 1024, fmt, args);
-
-    if (type == LOG_ERROR) std::cerr << "[" << LogTypeToString(type) << "][" << name << "]: " << buffer << "\n";
-    if (type != LOG_ERROR) std::cout << "[" << LogTypeToString(type) << "][" << name << "]: " << buffer << "\n";
-}
-
-AustinUtils::wlogger::wlogger(const std::wstring &name) {
-    this->name = name;
-}
-
-void AustinUtils::wlogger::c_log(LOG_TYPE type, const wchar_t *fmt, ...) {
-    va_list args;
-    wchar_t buffer[1024];
-
-    va_start(args, fmt);
-    vsnwprintf(buffer, 1024, fmt, args);
-    va_end(args);
-    if (type == LOG_ERROR) std::wcerr << "[" << LogTypeToWString(type) << "][" << name << "]: " << buffer << "\n";
-    if (type != LOG_ERROR) std::wcout << "[" << LogTypeToWString(type) << "][" << name << "]: " << buffer << "\n";
-}
-
-void AustinUtils::wlogger::c_log(LOG_TYPE type, const wchar_t *fmt, va_list args) {
-    wchar_t buffer[1024];
-
-
-    vsnwprintf(buffer, 1024, fmt, args);
-
-    if (type == LOG_ERROR) std::wcerr << "[" << LogTypeToWString(type) << "][" << name << "]: " << buffer << "\n";
-    if (type != LOG_ERROR) std::wcout << "[" << LogTypeToWString(type) << "][" << name << "]: " << buffer << "\n";
-}
+#include "logging.hpp"
+
+#include <algorithm>
+
+#include "Error.hpp"
+
+AUSTINUTILS std::string AustinUtils::LogTypeToString(const LOG_TYPE typ) {
+    switch (typ) {
+        case LOG_INFO:
+            return "INFO";
+        case LOG_WARN:
+            return "WARN";
+        case LOG_ERROR:
+            return "ERROR";
+        case LOG_DEBUG:
+            return "DEBUG";
+    }
+    return "LOG";
+}
+
+AUSTINUTILS std::wstring AustinUtils::LogTypeToWString(const LOG_TYPE typ) {
+    switch (typ) {
+        case AustinUtils::LOG_INFO:
+            return L"INFO";
+        case AustinUtils::LOG_WARN:
+            return L"WARN";
+        case AustinUtils::LOG_ERROR:
+            return L"ERROR";
+        case AustinUtils::LOG_DEBUG:
+            return L"DEBUG";
+    }
+    return L"LOG";
+}
+
+AustinUtils::logger_base::logger_base(std::string name) : name(std::move(name)) {
+    buildPrefixes();
+}
+
+AustinUtils::logger_base::logger_base(const logger_base& other) : name(other.name), queue(other.queue), min_severity(other.min_severity.load()),
+                                                                  record_severity(other.record_severity.load()), build_severity(other.build_severity.load()),
+                                                                  recorder(other.recorder),
+                                                                  field_mask(other.field_mask.load()), record_encoding(other.record_encoding.load()),
+                                                                  out(other.out), target(other.out.get()) {
+    buildPrefixes();
+}
+
+AustinUtils::logger_base& AustinUtils::logger_base::operator=(const logger_base& other) {
+    name = other.name;
+    buildPrefixes();
+    queue = other.queue;
+    min_severity.store(other.min_severity.load());
+    record_severity.store(other.record_severity.load());
+    build_severity.store(other.build_severity.load());
+    recorder = other.recorder;
+    field_mask.store(other.field_mask.load());
+    record_encoding.store(other.record_encoding.load());
+    replaceSink(other.out);
+    return *this;
+}
+
+void AustinUtils::logger_base::buildPrefixes() {
+    for (const LOG_TYPE type : {LOG_INFO, LOG_WARN, LOG_ERROR, LOG_DEBUG}) {
+        const std::string level = LogTypeToString(type);
+        prefixes[LOG_ENCODING_TEXT][type] = "[" + level + "][" + name + "]: ";
+
+        std::string& json = prefixes[LOG_ENCODING_JSON][type];
+        json = "\"level\":\"" + level + "\",\"logger\":";
+        log_append_string(json, LOG_ENCODING_JSON, name);
+
+        std::string& logfmt = prefixes[LOG_ENCODING_LOGFMT][type];
+        logfmt = "level=" + level + " logger=";
+        log_append_string(logfmt, LOG_ENCODING_LOGFMT, name);
+    }
+}
+
+//the LOG_TYPE with a given severity
+static AustinUtils::LOG_TYPE severityToType(const int severity) {
+    constexpr AustinUtils::LOG_TYPE types[] = {AustinUtils::LOG_DEBUG, AustinUtils::LOG_INFO, AustinUtils::LOG_WARN, AustinUtils::LOG_ERROR};
+    return types[severity];
+}
+
+void AustinUtils::logger_base::updateBuildSeverity() {
+    build_severity.store(std::min(min_severity.load(), record_severity.load()), std::memory_order_relaxed);
+}
+
+void AustinUtils::logger_base::set_level(const LOG_TYPE level) {
+    min_severity.store(LogSeverity(level), std::memory_order_relaxed);
+    updateBuildSeverity();
+}
+
+void AustinUtils::logger_base::set_recorder(const LOG_TYPE level, flight_recorder& recorder) {
+    this->recorder = &recorder;
+    record_severity.store(LogSeverity(level));
+    updateBuildSeverity();
+}
+
+void AustinUtils::logger_base::clear_recorder() {
+    //nothing is above severity 3, so nothing is recorded
+    record_severity.store(4);
+    updateBuildSeverity();
+    recorder = null;
+}
+
+AustinUtils::LOG_TYPE AustinUtils::logger_base::level() const {
+    return severityToType(min_severity.load(std::memory_order_relaxed));
+}
+
+void AustinUtils::logger_base::set_fields(const u32 fields) {
+    field_mask.store(fields, std::memory_order_relaxed);
+}
+
+AustinUtils::u32 AustinUtils::logger_base::fields() const {
+    return field_mask.load(std::memory_order_relaxed);
+}
+
+void AustinUtils::logger_base::set_encoding(const LOG_ENCODING encoding) {
+    record_encoding.store(encoding, std::memory_order_relaxed);
+}
+
+AustinUtils::LOG_ENCODING AustinUtils::logger_base::encoding() const {
+    return record_encoding.load(std::memory_order_relaxed);
+}
+
+AustinUtils::logger_base::~logger_base() {
+    if (deferred_active()) deferred_flush();
+    if (queue != null) queue->flush();
+}
+
+void AustinUtils::logger_base::write(const LOG_TYPE type, const std::string_view line) {
+    if (queue != null) {
+        queue->push(target.load(std::memory_order_acquire), type, line);
+        return;
+    }
+    target.load(std::memory_order_acquire)->write(type, line);
+}
+
+void AustinUtils::logger_base::finish(const LOG_TYPE type, const std::string_view line) {
+    if (recorder != null && LogSeverity(type) >= record_severity.load(std::memory_order_relaxed)) recorder->record(type, line);
+    if (enabled(type)) write(type, line);
+}
+
+void AustinUtils::logger_base::set_sink(std::shared_ptr<log_sink> sink) {
+    if (sink == null) throw Exception("Cannot log to a null sink, use null_sink to discard everything");
+    //queued lines still point at the old sink
+    if (queue != null) flush();
+    replaceSink(std::move(sink));
+}
+
+void AustinUtils::logger_base::replaceSink(std::shared_ptr<log_sink> sink) {
+    //swapping between the same few sinks keeps one reference to each
+    if (sink != out && std::find(retired.begin(), retired.end(), out) == retired.end()) retired.push_back(out);
+    out = std::move(sink);
+    target.store(out.get(), std::memory_order_release);
+}
+
+const std::shared_ptr<AustinUtils::log_sink>& AustinUtils::logger_base::sink() const {
+    return out;
+}
+
+void AustinUtils::logger_base::set_async(async_log_queue& queue) {
+    this->queue = &queue;
+}
+
+void AustinUtils::logger_base::set_sync() {
+    flush();
+    queue = null;
+}
+
+bool AustinUtils::logger_base::is_async() const {
+    return queue != null;
+}
+
+void AustinUtils::logger_base::flush() {
+    if (deferred_active()) deferred_flush();
+    if (queue != null) {
+        queue->flush();
+        return;
+    }
+    target.load(std::memory_order_acquire)->flush();
+}
+
+//appends fmt formatted with vsnprintf, trying the room buffer already has and formatting again into exactly enough room if that was too little
+static void appendFormatted(std::string& buffer, const char* fmt, va_list args) {
+    using AustinUtils::usize;
+    const usize start = buffer.size();
+    va_list retry;
+    va_copy(retry, args);
+    const usize room = std::max<usize>(buffer.capacity() - start, 256);
+    buffer.resize(start + room);
+    const int n = vsnprintf(buffer.data() + start, room + 1, fmt, args);
+    if (n < 0) {
+        buffer.resize(start);
+        buffer.append("(invalid format)");
+    } else if (cast(n, usize) > room) {
+        buffer.resize(start + n);
+        vsnprintf(buffer.data() + start, n + 1, fmt, retry);
+    } else {
+        buffer.resize(start + n);
+    }
+    va_end(retry);
+}
+
+void AustinUtils::logger_base::logText(const LOG_TYPE type, const std::string_view text) {
+    if (!wanted(type)) return;
+
+    log_line line;
+    std::string& buffer = line.get();
+    const LOG_ENCODING encoding = record_encoding.load(std::memory_order_relaxed);
+    appendPrefix(buffer, type, encoding);
+    if (encoding == LOG_ENCODING_TEXT) {
+        buffer.append(text);
+        buffer.push_back('\n');
+    } else {
+        log_open_message(buffer, encoding);
+        log_append_escaped(buffer, encoding, text);
+        log_close_message(buffer, encoding);
+        log_close_record(buffer, encoding);
+    }
+    finish(type, buffer);
+}
+
+void AustinUtils::logger_base::vformat(const LOG_TYPE type, const char* fmt, va_list args) {
+    log_line line;
+    std::string& buffer = line.get();
+    const LOG_ENCODING encoding = record_encoding.load(std::memory_order_relaxed);
+    appendPrefix(buffer, type, encoding);
+    if (encoding == LOG_ENCODING_TEXT) {
+        appendFormatted(buffer, fmt, args);
+        buffer.push_back('\n');
+    } else {
+        log_line text;
+        appendFormatted(text.get(), fmt, args);
+        log_open_message(buffer, encoding);
+        log_append_escaped(buffer, encoding, text.get());
+        log_close_message(buffer, encoding);
+        log_close_record(buffer, encoding);
+    }
+    finish(type, buffer);
+}
+
+void AustinUtils::logger_base::vformat(const LOG_TYPE type, const wchar_t* fmt, va_list args) {
+    using AustinUtils::usize;
+    //the wide printf does not say how much room it needed, so the buffer doubles until it fits and keeps its size for the next call
+    thread_local std::wstring buffer(256, L'\0');
+    loop {
+        va_list attempt;
+        va_copy(attempt, args);
+        const int n = vsnwprintf(buffer.data(), buffer.size(), fmt, attempt);
+        va_end(attempt);
+        if (n >= 0 && cast(n, usize) < buffer.size()) {
+            log_line text;
+            append_utf8(text.get(), std::wstring_view(buffer.data(), n));
+            logText(type, text.get());
+            return;
+        }
+        if (buffer.size() >= 1 << 24) {
+            logText(type, "(invalid format)");
+            return;
+        }
+        buffer.resize(buffer.size() * 2);
+    }
+}
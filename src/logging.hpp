@@ -1,110 +1,343 @@
-#ifndef LOGGING_HPP
-#define LOGGING_HPP
-
-#define AUSTINUTILS __declspec(dllexport)
-#include <iostream>
-#include <misc.hpp>
-#include <stdarg.h>
-#include <string>
-
-namespace AustinUtils {
-    enum LOG_TYPE {
-        LOG_INFO,
-        LOG_WARN,
-        LOG_ERROR,
-        LOG_DEBUG
-    };
-
-    extern AUSTINUTILS std::string LogTypeToString(LOG_TYPE typ);
-
-    extern AUSTINUTILS std::wstring LogTypeToWString(LOG_TYPE typ);
-
-
-
-    class AUSTINUTILS logger {
-        protected:
-        std::string name;
-
-        public:
-
-        logger() = default;
-
-        explicit logger(const std::string& name);
-
-        void c_log(LOG_TYPE type, const char *fmt, ...);
-
-        void c_log(LOG_TYPE type, const char *fmt, va_list args);
-
-        template<Formattable... Args>
-        void log(LOG_TYPE typ, Args... args) {
-            std::string buffer = AustinUtils::fmt(args...);
-            if (typ == LOG_ERROR) std::cerr << "[" << LogTypeToString(typ) << "][" << name << "]: " << buffer << "\n";
-            if (typ != LOG_ERROR) std::cout << "[" << LogTypeToString(typ) << "][" << name << "]: " << buffer << "\n";
-
-        }
-
-        template<Formattable... Args>
-        void info(Args... args) {
-            log(LOG_INFO, args...);
-        }
-
-        template<Formattable... Args>
-        void warn(Args... args) {
-            log(LOG_WARN, args...);
-        }
-
-        template<Formattable... Args>
-        void error(Args... args) {
-            log(LOG_ERROR, args...);
-        }
-
-        template<Formattable... Args>
-        void debug(Args... args) {
-            log(LOG_DEBUG, args...);
-        }
-    };
-
-    class AUSTINUTILS wlogger {
-    protected:
-        std::wstring name;
-
-    public:
-
-        explicit wlogger(const std::wstring& name);
-
-        void c_log(LOG_TYPE type, const wchar_t *fmt, ...);
-
-        void c_log(LOG_TYPE type, const wchar_t *fmt, va_list args);
-
-        template<WideFormattable... Args>
-        void log(LOG_TYPE typ, Args... args) {
-            std::wstring buffer = AustinUtils::wfmt(args...);
-            if (typ == LOG_ERROR) std::wcerr << "[" << LogTypeToWString(typ) << "][" << name << "]: " << buffer << "\n";
-            if (typ != LOG_ERROR) std::wcout << "[" << LogTypeToWString(typ) << "][" << name << "]: " << buffer << "\n";
-
-        }
-
-        template<WideFormattable... Args>
-        void info(Args... args) {
-            log(LOG_INFO, args...);
-        }
-
-        template<WideFormattable... Args>
-        void warn(Args... args) {
-            log(LOG_WARN, args...);
-        }
-
-        template<WideFormattable... Args>
-        void error(Args... args) {
-            log(LOG_ERROR, args...);
-        }
-
-        template<WideFormattable... Args>
-        void debug(Args... args) {
-            log(LOG_DEBUG, args...);
-        }
-    };
-
-}
-
-#endif
+#ifndef LOGGING_HPP
+#define LOGGING_HPP
+
+#define AUSTINUTILS __declspec(dllexport)
+#include <atomic>
+#include <iostream>
+#include <misc.hpp>
+#include <stdarg.h>
+#include <string>
+#include <vector>
+#include "asynclog.hpp"
+#include "logsink.hpp"
+#include "logformat.hpp"
+#include "loglimit.hpp"
+#include "logkv.hpp"
+#include "flightrecorder.hpp"
+
+namespace AustinUtils {
+    enum LOG_TYPE : int {
+        LOG_INFO,
+        LOG_WARN,
+        LOG_ERROR,
+        LOG_DEBUG
+    };
+
+    //how severe a LOG_TYPE is, from LOG_DEBUG up to LOG_ERROR, the enum itself is not in that order
+    NODISCARD constexpr int LogSeverity(const LOG_TYPE typ) {
+        switch (typ) {
+            case LOG_DEBUG:
+                return 0;
+            case LOG_INFO:
+                return 1;
+            case LOG_WARN:
+                return 2;
+            case LOG_ERROR:
+                return 3;
+        }
+        return 3;
+    }
+
+    /*
+     * the least severe level compiled in, define it as one of the LOG_TYPEs when building, for example -DAUSTINUTILS_LOG_MIN_LEVEL=LOG_WARN
+     * calls below it are removed at compile time, their arguments are never formatted
+     */
+#ifndef AUSTINUTILS_LOG_MIN_LEVEL
+#define AUSTINUTILS_LOG_MIN_LEVEL LOG_DEBUG
+#endif
+
+    //true if records of this level are compiled in at all
+    NODISCARD constexpr bool LogCompiledIn(const LOG_TYPE typ) {
+        return LogSeverity(typ) >= LogSeverity(AUSTINUTILS_LOG_MIN_LEVEL);
+    }
+
+    extern AUSTINUTILS std::string LogTypeToString(LOG_TYPE typ);
+
+    extern AUSTINUTILS std::wstring LogTypeToWString(LOG_TYPE typ);
+
+
+
+    /*
+     * everything logger and wlogger share: the sink, the async queue, level filtering, fields, encodings and the flight recorder
+     * lines are always built as UTF-8 in a std::string, a wide logger only differs in how it turns its arguments into that text
+     */
+    class AUSTINUTILS logger_base {
+        protected:
+        //UTF-8, a wide name is transcoded once
+        std::string name;
+        //"[LEVEL][name]: " for every LOG_TYPE, and its JSON and logfmt versions, built once
+        std::string prefixes[3][4];
+        async_log_queue* queue = null;
+        std::atomic<int> min_severity = 0;
+        //records from here up are recorded, and records from the lower of the two up are built at all
+        std::atomic<int> record_severity = 4;
+        std::atomic<int> build_severity = 0;
+        flight_recorder* recorder = null;
+        std::atomic<u32> field_mask = LOG_FIELD_NONE;
+        std::atomic<LOG_ENCODING> record_encoding = LOG_ENCODING_TEXT;
+        std::shared_ptr<log_sink> out = console_sink::global();
+        //what out points at, lines are written through this so a log_registry can swap the sink while other threads log
+        std::atomic<log_sink*> target = out.get();
+        //every sink out pointed at before, a thread that loaded target just before a swap may still be writing to it, so it lives as long as the logger
+        std::vector<std::shared_ptr<log_sink>> retired;
+
+        explicit logger_base(std::string name);
+
+        logger_base(const logger_base& other);
+
+        logger_base& operator =(const logger_base& other);
+
+        //waits for the deferred and queued records still referring to this logger
+        ~logger_base();
+
+        void buildPrefixes();
+
+        //points out and target at sink, retiring the old one
+        void replaceSink(std::shared_ptr<log_sink> sink);
+
+        void updateBuildSeverity();
+
+        //true if a record of this level has to be built, to be written or to be recorded
+        NODISCARD bool wanted(const LOG_TYPE typ) const {
+            return LogCompiledIn(typ) && LogSeverity(typ) >= build_severity.load(std::memory_order_relaxed);
+        }
+
+        //records a built line if it is severe enough, then writes it if it is enabled
+        void finish(LOG_TYPE type, std::string_view line);
+
+        //the start of a record up to where the message goes, the LOG_FIELDs asked for followed by "[LEVEL][name]: " or its equivalent
+        void appendPrefix(std::string& buffer, const LOG_TYPE type, const LOG_ENCODING encoding) const {
+            log_open_record(buffer, encoding);
+            if (const u32 fields = field_mask.load(std::memory_order_relaxed); fields != LOG_FIELD_NONE) {
+                log_append_fields(buffer, fields, fields & LOG_FIELD_TIME ? log_clock_now() : 0, log_thread_id(), encoding);
+            }
+            buffer.append(prefixes[encoding][type]);
+        }
+
+        //hands a finished line to the sink, or queues it when async
+        void write(LOG_TYPE type, std::string_view line);
+
+        //logs a message that is already UTF-8 text, as the message of a structured record if the encoding asks for one
+        void logText(LOG_TYPE type, std::string_view text);
+
+        //builds and logs a c_log record, formatted with vsnprintf or vswprintf into a reused per-thread buffer that grows as needed
+        void vformat(LOG_TYPE type, const char* fmt, va_list args);
+
+        void vformat(LOG_TYPE type, const wchar_t* fmt, va_list args);
+
+        friend class deferred_writer;
+        friend class log_registry;
+        friend AUSTINUTILS void deferred_commit();
+
+        public:
+
+        /*
+         * sends every line to sink from now on, the default is console_sink::global()
+         * safe while other threads log, the old sink is kept until the logger is destroyed, calls to set_sink itself must not race each other
+         */
+        void set_sink(std::shared_ptr<log_sink> sink);
+
+        NODISCARD const std::shared_ptr<log_sink>& sink() const;
+
+        //only records at least as severe as level are logged, the default is LOG_DEBUG which logs everything
+        void set_level(LOG_TYPE level);
+
+        NODISCARD LOG_TYPE level() const;
+
+        //true if a record of this level would be logged, a single relaxed load
+        NODISCARD bool enabled(const LOG_TYPE typ) const {
+            return LogCompiledIn(typ) && LogSeverity(typ) >= min_severity.load(std::memory_order_relaxed);
+        }
+
+        //puts the LOG_FIELDs in fields in front of every line from now on, LOG_FIELD_TIME | LOG_FIELD_THREAD for both, the default is none
+        void set_fields(u32 fields);
+
+        NODISCARD u32 fields() const;
+
+        //writes records as text, the default, or as one JSON object or logfmt line each
+        void set_encoding(LOG_ENCODING encoding);
+
+        NODISCARD LOG_ENCODING encoding() const;
+
+        /*
+         * copies every line at least as severe as level into recorder, including levels too verbose to be written, so they can be dumped
+         * when something goes wrong, see flight_recorder, deferred records are not recorded
+         */
+        void set_recorder(LOG_TYPE level = LOG_DEBUG, flight_recorder& recorder = flight_recorder::global());
+
+        //stops recording
+        void clear_recorder();
+
+        //hands every line to a background writer thread instead of writing it on the calling thread
+        void set_async(async_log_queue& queue = async_log_queue::global());
+
+        //writes on the calling thread again, after flushing what is still queued
+        void set_sync();
+
+        NODISCARD bool is_async() const;
+
+        //returns once everything this logger logged so far has been written, including deferred records
+        void flush();
+
+        /*
+         * logs a record whose text is built later on a background thread, the calling thread only copies the arguments
+         * lg.deferred<"user {} took {} ms">(LOG_INFO, id, ms);
+         * arguments must be arithmetic or convertible to std::string_view, the logger must outlive its records, flush() waits for them
+         * the time and thread fields are taken at the call, not when the text is built
+         */
+        template<log_format Format, typename... Args>
+        void deferred(const LOG_TYPE type, const Args&... args) {
+            if (!enabled(type)) return;
+            static constexpr deferred_site site = {Format.text, &deferred_format<Args...>};
+            u8* p = deferred_begin(this, &site, type, (usize{0} + ... + deferred_arg<Args>::size(args)));
+            ((p = deferred_arg<Args>::encode(p, args)), ...);
+            (void)p;
+            deferred_commit();
+        }
+    };
+
+    //what a logger of CharT can format, Formattable for char and WideFormattable for wchar_t
+    template<typename T, typename CharT>
+    concept LogFormattable = (std::is_same_v<CharT, char> && Formattable<T>) || (std::is_same_v<CharT, wchar_t> && WideFormattable<T>);
+
+    /*
+     * a logger whose name, formats and string arguments are made of CharT, use logger or wlogger
+     * both share logger_base, so a wlogger has the same sinks, async mode, fields and encodings, its wide text is transcoded to UTF-8
+     * as it is appended to the line and everything else is formatted exactly like the narrow logger does, no wide streams involved
+     */
+    template<typename CharT>
+    class basic_logger : public logger_base {
+        static_assert(std::is_same_v<CharT, char> || std::is_same_v<CharT, wchar_t>, "basic_logger is for char and wchar_t");
+
+        static std::string utf8(const std::basic_string<CharT>& s) {
+            if constexpr (std::is_same_v<CharT, char>) {
+                return s;
+            } else {
+                std::string out;
+                append_utf8(out, s);
+                return out;
+            }
+        }
+
+        template<typename T>
+        static void append(std::string& out, const T& x) {
+            if constexpr (std::is_same_v<CharT, char>) log_append(out, x);
+            else log_append_wide(out, x);
+        }
+
+    public:
+
+        basic_logger() : logger_base("") {}
+
+        explicit basic_logger(const std::basic_string<CharT>& name) : logger_base(utf8(name)) {}
+
+        //formats with vsnprintf, or vswprintf for wchar_t, into a reused per-thread buffer that grows as needed, long messages are never cut off
+        void c_log(LOG_TYPE type, const CharT* fmt, ...) {
+            if (!wanted(type)) return;
+            va_list args;
+
+            va_start(args, fmt);
+            vformat(type, fmt, args);
+            va_end(args);
+        }
+
+        void c_log(LOG_TYPE type, const CharT* fmt, va_list args) {
+            if (!wanted(type)) return;
+            vformat(type, fmt, args);
+        }
+
+        /*
+         * builds the line in a reused per-thread buffer, common argument types are formatted without a stream
+         * kv(key, value) arguments become fields of their own in JSON and logfmt, in text they are appended as key=value, narrow loggers only
+         */
+        template<LogFormattable<CharT>... Args>
+        void log(LOG_TYPE typ, const Args&... args) {
+            if (!wanted(typ)) return;
+            log_line line;
+            std::string& buffer = line.get();
+            const LOG_ENCODING encoding = record_encoding.load(std::memory_order_relaxed);
+            appendPrefix(buffer, typ, encoding);
+            if (encoding == LOG_ENCODING_TEXT) {
+                (append(buffer, args), ...);
+                buffer.push_back('\n');
+            } else {
+                log_open_message(buffer, encoding);
+                if constexpr (std::is_same_v<CharT, char>) {
+                    (log_append_message(buffer, encoding, args), ...);
+                    log_close_message(buffer, encoding);
+                    (log_append_kv(buffer, encoding, args), ...);
+                } else {
+                    log_line text;
+                    (log_append_wide(text.get(), args), ...);
+                    log_append_escaped(buffer, encoding, text.get());
+                    log_close_message(buffer, encoding);
+                }
+                log_close_record(buffer, encoding);
+            }
+            finish(typ, buffer);
+        }
+
+        //logs the 1st, n+1th, 2n+1th... record reaching site, which has to live as long as the call site, usually a static
+        template<LogFormattable<CharT>... Args>
+        void log_every_n(log_counter& site, const u64 n, const LOG_TYPE typ, const Args&... args) {
+            if (enabled(typ) && site.every(n)) log(typ, args...);
+        }
+
+        //logs the first n records reaching site
+        template<LogFormattable<CharT>... Args>
+        void log_first_n(log_counter& site, const u64 n, const LOG_TYPE typ, const Args&... args) {
+            if (enabled(typ) && site.first(n)) log(typ, args...);
+        }
+
+        //logs while site has tokens left, the first record let through after some were refused is preceded by how many
+        template<LogFormattable<CharT>... Args>
+        void log_rate_limited(log_rate& site, const LOG_TYPE typ, const Args&... args) {
+            if (!enabled(typ)) return;
+            u64 suppressed = 0;
+            if (!site.acquire(suppressed)) return;
+            if (suppressed != 0) log(typ, suppressed, " records suppressed by the rate limit");
+            log(typ, args...);
+        }
+
+        //formats the record and drops it if its text repeats the last one of site, see log_dedup
+        template<LogFormattable<CharT>... Args>
+        void log_deduplicated(log_dedup& site, const LOG_TYPE typ, const Args&... args) {
+            if (!enabled(typ)) return;
+            log_line message;
+            std::string& text = message.get();
+            (append(text, args), ...);
+            u64 repeated = 0;
+            if (!site.admit(text, repeated)) return;
+            if (repeated != 0) log(typ, "previous message repeated ", repeated, " times");
+            //the text is reused as it is unless kv arguments have to become fields
+            if (record_encoding.load(std::memory_order_relaxed) == LOG_ENCODING_TEXT || !std::is_same_v<CharT, char>) logText(typ, text);
+            else log(typ, args...);
+        }
+
+        template<LogFormattable<CharT>... Args>
+        void info(const Args&... args) {
+            if constexpr (LogCompiledIn(LOG_INFO)) log(LOG_INFO, args...);
+        }
+
+        template<LogFormattable<CharT>... Args>
+        void warn(const Args&... args) {
+            if constexpr (LogCompiledIn(LOG_WARN)) log(LOG_WARN, args...);
+        }
+
+        template<LogFormattable<CharT>... Args>
+        void error(const Args&... args) {
+            if constexpr (LogCompiledIn(LOG_ERROR)) log(LOG_ERROR, args...);
+        }
+
+        template<LogFormattable<CharT>... Args>
+        void debug(const Args&... args) {
+            if constexpr (LogCompiledIn(LOG_DEBUG)) log(LOG_DEBUG, args...);
+        }
+    };
+
+    using logger = basic_logger<char>;
+    using wlogger = basic_logger<wchar_t>;
+
+}
+
+#endif
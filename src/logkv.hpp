@@ -0,0 +1,111 @@
+#ifndef LOGKV_HPP
+#define LOGKV_HPP
+
+#include <cmath>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "misc.hpp"
+#include "logformat.hpp"
+
+#define AUSTINUTILS __declspec(dllexport)
+
+/*
+ * structured logging, lg.info("request done", kv("user", id), kv("ms", dt))
+ * a JSON or logfmt logger writes the plain arguments as the message and every kv as a field of its own,
+ * encoded straight into the line buffer, a text logger appends them to the message as key=value
+ */
+
+namespace AustinUtils {
+
+    //a key and a reference to its value, only valid for the call it is made in
+    template<typename T>
+    struct log_kv {
+        std::string_view key;
+        const T& value;
+    };
+
+    //the value can be anything Formattable, numbers and bools are written as JSON numbers and bools, everything else as a string
+    template<Formattable T>
+    NODISCARD log_kv<T> kv(const std::string_view key, const T& value) {
+        return {key, value};
+    }
+
+    template<typename T>
+    struct is_log_kv : std::false_type {};
+
+    template<typename T>
+    struct is_log_kv<log_kv<T>> : std::true_type {};
+
+    //appends a value the way encoding writes it
+    template<typename T>
+    void log_append_value(std::string& out, const LOG_ENCODING encoding, const T& x) {
+        if constexpr (std::is_same_v<T, bool>) {
+            out.append(x ? "true" : "false");
+        } else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>) {
+            const char c = cast(x, char);
+            log_append_string(out, encoding, std::string_view(&c, 1));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            //JSON has no nan or inf
+            if (encoding == LOG_ENCODING_JSON && !std::isfinite(x)) out.append("null");
+            else log_append(out, x);
+        } else if constexpr (std::is_integral_v<T>) {
+            log_append(out, x);
+        } else if constexpr (std::is_pointer_v<T> && std::is_convertible_v<T, const char*>) {
+            log_append_string(out, encoding, x == null ? "(null)" : x);
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view> && !std::is_pointer_v<T>) {
+            log_append_string(out, encoding, std::string_view(x));
+        } else {
+            log_line text;
+            log_append(text.get(), x);
+            log_append_string(out, encoding, text.get());
+        }
+    }
+
+    //a text logger writes a kv inside the message as key=value
+    template<typename T>
+    void log_append(std::string& out, const log_kv<T>& x) {
+        if (!out.empty() && out.back() != ' ') out.push_back(' ');
+        log_append_key(out, LOG_ENCODING_TEXT, x.key);
+        out.push_back('=');
+        log_append_value(out, LOG_ENCODING_TEXT, x.value);
+    }
+
+    //appends a plain argument to an open message, kv arguments are left for log_append_kv
+    template<typename T>
+    void log_append_message(std::string& out, const LOG_ENCODING encoding, const T& x) {
+        if constexpr (is_log_kv<T>::value) {
+            return;
+        } else if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, char> && !std::is_same_v<T, signed char> && !std::is_same_v<T, unsigned char>) {
+            //nothing a number turns into needs escaping
+            log_append(out, x);
+        } else if constexpr (std::is_pointer_v<T> && std::is_convertible_v<T, const char*>) {
+            log_append_escaped(out, encoding, x == null ? "(null)" : x);
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view> && !std::is_pointer_v<T>) {
+            log_append_escaped(out, encoding, std::string_view(x));
+        } else {
+            log_line text;
+            log_append(text.get(), x);
+            log_append_escaped(out, encoding, text.get());
+        }
+    }
+
+    //appends a kv argument as a field of its own, plain arguments are skipped
+    template<typename T>
+    void log_append_kv(std::string& out, const LOG_ENCODING encoding, const T& x) {
+        if constexpr (is_log_kv<T>::value) {
+            out.push_back(encoding == LOG_ENCODING_JSON ? ',' : ' ');
+            log_append_key(out, encoding, x.key);
+            out.push_back(encoding == LOG_ENCODING_JSON ? ':' : '=');
+            log_append_value(out, encoding, x.value);
+        }
+    }
+
+    template<typename T>
+    std::ostream& operator <<(std::ostream& os, const log_kv<T>& x) {
+        return os << x.key << '=' << x.value;
+    }
+}
+
+#endif
@@ -0,0 +1,66 @@
+#include "loglimit.hpp"
+
+#include <functional>
+
+#include "Error.hpp"
+
+
+namespace AustinUtils {
+
+    static u64 steady_now() {
+        return cast(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(), u64);
+    }
+
+    bool log_counter::every(const u64 n) {
+        const u64 hit = hits.fetch_add(1, std::memory_order_relaxed);
+        return n <= 1 || hit % n == 0;
+    }
+
+    bool log_counter::first(const u64 n) {
+        //once past n the counter is only read, so a flood does not keep a cache line bouncing between cores
+        if (hits.load(std::memory_order_relaxed) >= n) return false;
+        return hits.fetch_add(1, std::memory_order_relaxed) < n;
+    }
+
+    u64 log_counter::count() const {
+        return hits.load(std::memory_order_relaxed);
+    }
+
+
+    log_rate::log_rate(const double rate, const u64 burst) {
+        if (!(rate > 0)) throw Exception("A log rate must be positive, got ", rate);
+        if (burst == 0) throw Exception("A log rate needs a burst of at least 1");
+        interval = std::max<u64>(cast(1e9 / rate, u64), 1);
+        tolerance = interval * (burst - 1);
+    }
+
+    bool log_rate::acquire(u64& suppressed) {
+        const u64 now = steady_now();
+        u64 t = arrival.load(std::memory_order_relaxed);
+        loop {
+            if (t > now + tolerance) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            if (arrival.compare_exchange_weak(t, std::max(t, now) + interval, std::memory_order_relaxed)) break;
+        }
+        suppressed = dropped.load(std::memory_order_relaxed) == 0 ? 0 : dropped.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+
+
+    log_dedup::log_dedup(const std::chrono::nanoseconds window) : window(cast(window.count(), u64)) {}
+
+    bool log_dedup::admit(const std::string_view message, u64& repeated) {
+        //0 is the "nothing logged yet" value
+        const u64 hash = std::hash<std::string_view>()(message) | 1;
+        const u64 now = steady_now();
+        if (last.exchange(hash, std::memory_order_relaxed) == hash && now - since.load(std::memory_order_relaxed) < window) {
+            repeats.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        since.store(now, std::memory_order_relaxed);
+        repeated = repeats.load(std::memory_order_relaxed) == 0 ? 0 : repeats.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+}
@@ -0,0 +1,95 @@
+#ifndef LOGLIMIT_HPP
+#define LOGLIMIT_HPP
+
+#include <atomic>
+#include <chrono>
+#include <string_view>
+#include "misc.hpp"
+
+#define AUSTINUTILS __declspec(dllexport)
+
+/*
+ * per call site state for sampled and rate limited logging, see logger::log_every_n and friends
+ * keep one in a static at the call site, or use the AUSTINUTILS_LOG_* macros which do that for you
+ * every check is a few relaxed atomic operations, done before anything is formatted
+ */
+
+namespace AustinUtils {
+
+    //counts the calls of a site for log_every_n and log_first_n
+    class AUSTINUTILS log_counter {
+        std::atomic<u64> hits = 0;
+
+    public:
+
+        //true for the 1st, n+1th, 2n+1th... call
+        bool every(u64 n);
+
+        //true for the first n calls, later calls do not even count
+        bool first(u64 n);
+
+        NODISCARD u64 count() const;
+    };
+
+    /*
+     * a token bucket, rate records a second on average with bursts of up to burst records
+     * kept as a single atomic "theoretical arrival time" (GCRA), so taking a token is one compare and swap
+     */
+    class AUSTINUTILS log_rate {
+        std::atomic<u64> arrival = 0;
+        std::atomic<u64> dropped = 0;
+        u64 interval;
+        u64 tolerance;
+
+    public:
+
+        //throws if rate is not positive or burst is 0
+        explicit log_rate(double rate, u64 burst = 1);
+
+        //takes a token, on success suppressed is how many records were refused since the last one that got through
+        bool acquire(u64& suppressed);
+    };
+
+    /*
+     * drops a site's record when its text is the same as the one before, within window of the last one written
+     * the next record that is written gets a "previous message repeated N times" line in front of it
+     * threads logging different messages through the same site at once can make the count a little off, never a line
+     */
+    class AUSTINUTILS log_dedup {
+        std::atomic<u64> last = 0;
+        std::atomic<u64> repeats = 0;
+        std::atomic<u64> since = 0;
+        u64 window;
+
+    public:
+
+        explicit log_dedup(std::chrono::nanoseconds window = std::chrono::seconds(10));
+
+        //false if message repeats the last one, on true repeated is how many repeats were dropped before it
+        bool admit(std::string_view message, u64& repeated);
+    };
+}
+
+//the same as lg.log_every_n(site, n, type, ...) with a static site of its own
+#define AUSTINUTILS_LOG_EVERY_N(lg, n, type, ...) do { \
+    static AustinUtils::log_counter austinutils_site_; \
+    (lg).log_every_n(austinutils_site_, n, type, __VA_ARGS__); \
+} while (0)
+
+#define AUSTINUTILS_LOG_FIRST_N(lg, n, type, ...) do { \
+    static AustinUtils::log_counter austinutils_site_; \
+    (lg).log_first_n(austinutils_site_, n, type, __VA_ARGS__); \
+} while (0)
+
+//rate records a second, bursts of up to burst
+#define AUSTINUTILS_LOG_RATE_LIMITED(lg, rate, burst, type, ...) do { \
+    static AustinUtils::log_rate austinutils_site_(rate, burst); \
+    (lg).log_rate_limited(austinutils_site_, type, __VA_ARGS__); \
+} while (0)
+
+#define AUSTINUTILS_LOG_DEDUPLICATED(lg, type, ...) do { \
+    static AustinUtils::log_dedup austinutils_site_; \
+    (lg).log_deduplicated(austinutils_site_, type, __VA_ARGS__); \
+} while (0)
+
+#endif
@@ -0,0 +1,184 @@
+#include "logregistry.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <unordered_map>
+
+#include "Error.hpp"
+
+
+namespace AustinUtils {
+
+    static std::atomic<u64> next_registry = 1;
+
+    //looks a std::string up by string_view without building one
+    struct name_hash {
+        using is_transparent = void;
+
+        usize operator ()(const std::string_view s) const {
+            return std::hash<std::string_view>()(s);
+        }
+    };
+
+    //the loggers this thread has already asked a registry for, loggers are never removed so the pointers stay valid
+    struct registry_cache {
+        u64 registry;
+        std::unordered_map<std::string, logger*, name_hash, std::equal_to<>> loggers;
+    };
+
+    static thread_local std::vector<registry_cache> caches;
+
+    log_registry::log_registry() : id(next_registry.fetch_add(1)) {
+        node& root = nodes[""];
+        root.log = std::make_unique<logger>("root");
+        root.level = LOG_DEBUG;
+        root.sink = console_sink::global();
+        sinks.push_back(root.sink);
+    }
+
+    LOG_TYPE log_registry::levelOf(const node& n) {
+        const node* p = &n;
+        while (!p->level.has_value()) p = p->parent;
+        return *p->level;
+    }
+
+    const std::shared_ptr<log_sink>& log_registry::sinkOf(const node& n) {
+        const node* p = &n;
+        while (p->sink == null) p = p->parent;
+        return p->sink;
+    }
+
+    log_registry::node& log_registry::find(const std::string_view name) {
+        if (const auto it = nodes.find(name); it != nodes.end()) return it->second;
+
+        const usize dot = name.rfind('.');
+        node& parent = find(dot == std::string_view::npos ? std::string_view() : name.substr(0, dot));
+        node& n = nodes[std::string(name)];
+        n.parent = &parent;
+        parent.children.push_back(&n);
+        n.log = std::make_unique<logger>(std::string(name));
+        n.log->set_level(levelOf(n));
+        n.log->set_sink(sinkOf(n));
+        return n;
+    }
+
+    void log_registry::propagate(node& n) {
+        n.log->set_level(levelOf(n));
+        //the sink is swapped with one atomic store, lines being written to the old one finish there
+        log_sink* sink = sinkOf(n).get();
+        if (n.log->target.load() != sink) {
+            if (n.log->queue != null) n.log->flush();
+            n.log->out = sinkOf(n);
+            n.log->target.store(sink, std::memory_order_release);
+        }
+        for (node* child : n.children) {
+            //a child with its own level and sink is not affected, nor is anything below it
+            if (!child->level.has_value() || child->sink == null) propagate(*child);
+        }
+    }
+
+    logger& log_registry::get(const std::string_view name) {
+        registry_cache* cache = null;
+        for (registry_cache& c : caches) {
+            if (c.registry == id) cache = &c;
+        }
+        if (cache == null) cache = &caches.emplace_back(registry_cache{id, {}});
+        if (const auto it = cache->loggers.find(name); it != cache->loggers.end()) return *it->second;
+
+        logger* log;
+        {
+            std::lock_guard guard(lock);
+            log = find(name).log.get();
+        }
+        cache->loggers.emplace(std::string(name), log);
+        return *log;
+    }
+
+    void log_registry::set_level(const std::string_view name, const LOG_TYPE level) {
+        std::lock_guard guard(lock);
+        node& n = find(name);
+        n.level = level;
+        propagate(n);
+    }
+
+    void log_registry::clear_level(const std::string_view name) {
+        std::lock_guard guard(lock);
+        node& n = find(name);
+        //the root always has one
+        if (n.parent == null) return;
+        n.level.reset();
+        propagate(n);
+    }
+
+    LOG_TYPE log_registry::level(const std::string_view name) {
+        std::lock_guard guard(lock);
+        return levelOf(find(name));
+    }
+
+    void log_registry::set_sink(const std::string_view name, std::shared_ptr<log_sink> sink) {
+        if (sink == null) throw Exception("Cannot log to a null sink, use null_sink to discard everything");
+        std::lock_guard guard(lock);
+        node& n = find(name);
+        if (std::find(sinks.begin(), sinks.end(), sink) == sinks.end()) sinks.push_back(sink);
+        n.sink = std::move(sink);
+        propagate(n);
+    }
+
+    void log_registry::clear_sink(const std::string_view name) {
+        std::lock_guard guard(lock);
+        node& n = find(name);
+        if (n.parent == null) return;
+        n.sink = null;
+        propagate(n);
+    }
+
+    //the LOG_TYPE called s, in any case
+    static LOG_TYPE parseLevel(std::string_view s) {
+        while (!s.empty() && std::isspace(cast(s.front(), u8))) s.remove_prefix(1);
+        while (!s.empty() && std::isspace(cast(s.back(), u8))) s.remove_suffix(1);
+        for (const LOG_TYPE type : {LOG_INFO, LOG_WARN, LOG_ERROR, LOG_DEBUG}) {
+            const std::string level = LogTypeToString(type);
+            if (std::equal(s.begin(), s.end(), level.begin(), level.end(), [](const char a, const char b) {
+                return std::toupper(cast(a, u8)) == b;
+            })) return type;
+        }
+        throw Exception("Unknown log level \"", std::string(s), "\"");
+    }
+
+    void log_registry::configure(std::string_view levels) {
+        while (!levels.empty()) {
+            const usize comma = levels.find(',');
+            std::string_view entry = levels.substr(0, comma);
+            levels = comma == std::string_view::npos ? std::string_view() : levels.substr(comma + 1);
+
+            std::string_view name;
+            if (const usize eq = entry.find('='); eq != std::string_view::npos) {
+                name = entry.substr(0, eq);
+                entry = entry.substr(eq + 1);
+                while (!name.empty() && std::isspace(cast(name.front(), u8))) name.remove_prefix(1);
+                while (!name.empty() && std::isspace(cast(name.back(), u8))) name.remove_suffix(1);
+            }
+            if (entry.find_first_not_of(" \t") == std::string_view::npos && name.empty()) continue;
+            set_level(name, parseLevel(entry));
+        }
+    }
+
+    void log_registry::flush() {
+        std::vector<logger*> loggers;
+        {
+            std::lock_guard guard(lock);
+            for (auto& [name, n] : nodes) loggers.push_back(n.log.get());
+        }
+        for (logger* log : loggers) log->flush();
+    }
+
+    log_registry& log_registry::global() {
+        static log_registry registry;
+        return registry;
+    }
+
+    logger& GetLogger(const std::string_view name) {
+        return log_registry::global().get(name);
+    }
+}
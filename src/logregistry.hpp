@@ -0,0 +1,92 @@
+#ifndef LOGREGISTRY_HPP
+#define LOGREGISTRY_HPP
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "misc.hpp"
+#include "logging.hpp"
+
+#define AUSTINUTILS __declspec(dllexport)
+
+/*
+ * named loggers arranged by their dots, "db.pool" is a child of "db", which is a child of the root ""
+ * a logger without a level or sink of its own uses the nearest ancestor's, changes reach every logger below at once through atomic stores
+ * get() takes the lock only the first time a thread asks for a name, after that it is a lookup in a per-thread cache
+ */
+
+namespace AustinUtils {
+
+    class AUSTINUTILS log_registry {
+        struct node {
+            std::unique_ptr<logger> log;
+            std::optional<LOG_TYPE> level;
+            std::shared_ptr<log_sink> sink;
+            node* parent = null;
+            std::vector<node*> children;
+        };
+
+        u64 id;
+        std::mutex lock;
+        //std::less<> so names can be looked up as string_views
+        std::map<std::string, node, std::less<>> nodes;
+        //every sink ever set, loggers write through plain pointers so a replaced sink has to stay alive
+        std::vector<std::shared_ptr<log_sink>> sinks;
+
+        node& find(std::string_view name);
+
+        //hands node's level and sink, its own or inherited, to its logger and everything below it
+        void propagate(node& n);
+
+        NODISCARD static LOG_TYPE levelOf(const node& n);
+
+        NODISCARD static const std::shared_ptr<log_sink>& sinkOf(const node& n);
+
+    public:
+
+        //the root starts at LOG_DEBUG writing to console_sink::global()
+        log_registry();
+
+        log_registry(const log_registry&) = delete;
+
+        log_registry& operator =(const log_registry&) = delete;
+
+        //the logger called name, created with its inherited level and sink the first time, it lives as long as the registry
+        logger& get(std::string_view name);
+
+        //sets the level of name and of everything below it that has no level of its own, "" is the root
+        void set_level(std::string_view name, LOG_TYPE level);
+
+        //name goes back to its parent's level
+        void clear_level(std::string_view name);
+
+        //the level name logs at, its own or inherited
+        NODISCARD LOG_TYPE level(std::string_view name);
+
+        //sends the lines of name and of everything below it without a sink of its own to sink, which the registry keeps alive
+        void set_sink(std::string_view name, std::shared_ptr<log_sink> sink);
+
+        //name goes back to its parent's sink
+        void clear_sink(std::string_view name);
+
+        /*
+         * applies a list of levels like "warn,db=debug,db.pool=error", an entry without a name is the root
+         * levels are info, warn, error or debug in any case, throws on anything else
+         */
+        void configure(std::string_view levels);
+
+        //flushes every logger
+        void flush();
+
+        static log_registry& global();
+    };
+
+    //log_registry::global().get(name)
+    extern AUSTINUTILS logger& GetLogger(std::string_view name);
+}
+
+#endif
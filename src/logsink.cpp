@@ -0,0 +1,213 @@
+#include "logsink.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "Error.hpp"
+#include "logging.hpp"
+
+
+namespace AustinUtils {
+
+    void console_sink::write(const LOG_TYPE type, const std::string_view lines) {
+        std::ostream& os = type == LOG_ERROR ? std::cerr : std::cout;
+        os.write(lines.data(), cast(lines.size(), std::streamsize));
+    }
+
+    void console_sink::flush() {
+        std::cout.flush();
+        std::cerr.flush();
+    }
+
+    std::shared_ptr<log_sink> console_sink::global() {
+        static const std::shared_ptr<log_sink> sink = std::make_shared<console_sink>();
+        return sink;
+    }
+
+
+    fanout_sink::fanout_sink(std::vector<std::shared_ptr<log_sink>> sinks) : sinks(std::move(sinks)) {}
+
+    void fanout_sink::write(const LOG_TYPE type, const std::string_view lines) {
+        for (const std::shared_ptr<log_sink>& sink : sinks) sink->write(type, lines);
+    }
+
+    void fanout_sink::flush() {
+        for (const std::shared_ptr<log_sink>& sink : sinks) sink->flush();
+    }
+
+    void fanout_sink::submit() {
+        for (const std::shared_ptr<log_sink>& sink : sinks) sink->submit();
+    }
+
+
+    file_sink_options::file_sink_options() : flush_on(LOG_ERROR) {}
+
+    file_sink::file_sink(std::string path, const file_sink_options options) : path(std::move(path)), options(options) {
+        if (this->options.buffer_bytes == 0) this->options.buffer_bytes = 1;
+        active.reserve(this->options.buffer_bytes);
+        spare.reserve(this->options.buffer_bytes);
+        const int file = ::open(this->path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (file < 0) throw Exception("Could not open log file ", this->path, ": ", std::strerror(errno));
+        use(file);
+    }
+
+    file_sink::~file_sink() {
+        flush();
+        if (fd >= 0) ::close(fd);
+    }
+
+    const std::string& file_sink::file() const {
+        return path;
+    }
+
+    void file_sink::use(const int file) {
+        fd = file;
+        const auto end = ::lseek(fd, 0, SEEK_END);
+        file_bytes = end < 0 ? 0 : cast(end, u64);
+        opened = std::chrono::system_clock::now();
+    }
+
+    //straight to stderr, this runs on the async writer and in the destructor where an exception would end the process
+    static void reportOpenFailure(const std::string& path, const int error) {
+        char message[512];
+        const int n = std::snprintf(message, sizeof(message), "[ERROR][log]: could not open log file %s: %s, still writing to the old file\n",
+                                    path.c_str(), std::strerror(error));
+        if (n <= 0) return;
+        if (::write(2, message, cast(std::min<usize>(n, sizeof(message) - 1), unsigned)) < 0) return;
+    }
+
+    void file_sink::rotate() {
+        //only the open is retried after a failed one, the files were already moved along
+        if (!rotation_pending) {
+            if (options.max_files == 0) {
+                std::remove(path.c_str());
+            } else {
+                //path.n-1 -> path.n ... path -> path.1, the oldest falls off the end
+                std::remove((path + "." + std::to_string(options.max_files)).c_str());
+                for (usize i = options.max_files; i > 1; i--) {
+                    std::rename((path + "." + std::to_string(i-1)).c_str(), (path + "." + std::to_string(i)).c_str());
+                }
+                std::rename(path.c_str(), (path + ".1").c_str());
+            }
+        }
+
+        //the old file stays open until the new one is, so a failure loses nothing
+        const int file = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (file < 0) {
+            if (!rotation_pending) reportOpenFailure(path, errno);
+            rotation_pending = true;
+            retry_at = std::chrono::system_clock::now() + std::chrono::seconds(1);
+            return;
+        }
+        ::close(fd);
+        rotation_pending = false;
+        use(file);
+    }
+
+    void file_sink::output(std::string_view data) {
+        if (data.empty() || fd < 0) return;
+        const auto now = std::chrono::system_clock::now();
+        if (rotation_pending) {
+            if (now >= retry_at) rotate();
+        } else {
+            const bool too_big = options.max_bytes != 0 && file_bytes != 0 && file_bytes + data.size() > options.max_bytes;
+            const bool too_old = options.rotate_seconds != 0 && now - opened >= std::chrono::seconds(options.rotate_seconds);
+            if (too_big || too_old) rotate();
+        }
+
+        while (!data.empty()) {
+            const auto n = ::write(fd, data.data(), cast(data.size(), unsigned));
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                //nowhere left to report it, drop the rest
+                return;
+            }
+            data.remove_prefix(n);
+            file_bytes += n;
+        }
+    }
+
+    void file_sink::write(const LOG_TYPE type, const std::string_view lines) {
+        const bool urgent = LogSeverity(type) >= LogSeverity(options.flush_on);
+        std::unique_lock guard(lock);
+        if (active.size() + lines.size() <= options.buffer_bytes && !urgent) {
+            active.append(lines);
+            return;
+        }
+
+        //swap the full buffer out and write it without holding up other threads
+        std::unique_lock io(io_lock);
+        std::swap(active, spare);
+        const bool fits = lines.size() <= options.buffer_bytes;
+        if (fits) spare.append(lines);
+        guard.unlock();
+        output(spare);
+        spare.clear();
+        if (!fits) output(lines);
+    }
+
+    void file_sink::flush() {
+        std::unique_lock guard(lock);
+        std::unique_lock io(io_lock);
+        std::swap(active, spare);
+        guard.unlock();
+        output(spare);
+        spare.clear();
+    }
+
+
+    void append_utf8(std::string& out, const std::wstring_view s) {
+        for (usize i = 0; i < s.size(); i++) {
+            //a run of ASCII, the usual log text, is copied with one resize and a loop the compiler vectorizes
+            usize ascii = i;
+            while (ascii < s.size() && cast(s[ascii], u32) < 0x80) ascii++;
+            if (ascii != i) {
+                const usize start = out.size();
+                out.resize(start + ascii - i);
+                char* p = out.data() + start;
+                for (usize j = i; j < ascii; j++) *p++ = cast(s[j], char);
+                i = ascii - 1;
+                continue;
+            }
+
+            u32 c = cast(s[i], u32);
+            if constexpr (sizeof(wchar_t) == 2) {
+                c &= 0xFFFF;
+                if (c >= 0xD800 && c < 0xDC00 && i + 1 < s.size()) {
+                    const u32 low = cast(s[i+1], u32) & 0xFFFF;
+                    if (low >= 0xDC00 && low < 0xE000) {
+                        c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+                        i++;
+                    }
+                }
+            }
+            //lone surrogates and values past unicode become U+FFFD
+            if ((c >= 0xD800 && c < 0xE000) || c > 0x10FFFF) c = 0xFFFD;
+
+            if (c < 0x80) {
+                out.push_back(cast(c, char));
+            } else if (c < 0x800) {
+                out.push_back(cast(0xC0 | c >> 6, char));
+                out.push_back(cast(0x80 | (c & 0x3F), char));
+            } else if (c < 0x10000) {
+                out.push_back(cast(0xE0 | c >> 12, char));
+                out.push_back(cast(0x80 | (c >> 6 & 0x3F), char));
+                out.push_back(cast(0x80 | (c & 0x3F), char));
+            } else {
+                out.push_back(cast(0xF0 | c >> 18, char));
+                out.push_back(cast(0x80 | (c >> 12 & 0x3F), char));
+                out.push_back(cast(0x80 | (c >> 6 & 0x3F), char));
+                out.push_back(cast(0x80 | (c & 0x3F), char));
+            }
+        }
+    }
+}
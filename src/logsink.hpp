@@ -0,0 +1,138 @@
+#ifndef LOGSINK_HPP
+#define LOGSINK_HPP
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "misc.hpp"
+
+#define AUSTINUTILS __declspec(dllexport)
+
+/*
+ * where loggers send their finished lines, one sink can be shared by any number of loggers
+ * an async logger's sink is only ever written by the queue's writer thread, which submits it once per batch and flushes it when idle
+ */
+
+namespace AustinUtils {
+
+    enum LOG_TYPE : int;
+
+    class AUSTINUTILS log_sink {
+    public:
+        virtual ~log_sink() = default;
+
+        //takes one or more finished lines, each ending in '\n', of the given level
+        virtual void write(LOG_TYPE type, std::string_view lines) = 0;
+
+        //pushes out anything the sink is holding on to, returning once it is written
+        virtual void flush() {}
+
+        //hands what the sink is holding on to over without waiting for it to be written, an async writer calls this after every batch
+        virtual void submit() {
+            flush();
+        }
+    };
+
+    //stdout, or stderr for LOG_ERROR, the default sink
+    class AUSTINUTILS console_sink : public log_sink {
+    public:
+        void write(LOG_TYPE type, std::string_view lines) override;
+
+        void flush() override;
+
+        static std::shared_ptr<log_sink> global();
+    };
+
+    //discards everything, for benchmarks and for silencing a logger
+    class AUSTINUTILS null_sink : public log_sink {
+    public:
+        void write(LOG_TYPE, std::string_view) override {}
+    };
+
+    //forwards every line to several sinks
+    class AUSTINUTILS fanout_sink : public log_sink {
+        std::vector<std::shared_ptr<log_sink>> sinks;
+
+    public:
+        explicit fanout_sink(std::vector<std::shared_ptr<log_sink>> sinks);
+
+        void write(LOG_TYPE type, std::string_view lines) override;
+
+        void flush() override;
+
+        void submit() override;
+    };
+
+    struct file_sink_options {
+        //lines are collected in a buffer of this size and written with one write call when it fills up
+        usize buffer_bytes = 1 << 20;
+        //start a new file once the current one would grow past this, 0 never rotates on size
+        u64 max_bytes = 0;
+        //start a new file once the current one is this old, 0 never rotates on time
+        u64 rotate_seconds = 0;
+        //rotated files are kept as path.1 (the newest) up to path.max_files
+        usize max_files = 5;
+        //lines at least this severe are written out straight away
+        LOG_TYPE flush_on;
+
+        file_sink_options();
+    };
+
+    /*
+     * appends lines to a file through a large buffer and plain write calls, no iostreams involved
+     * the buffer is swapped for a spare one before writing, so other threads keep appending while the write is in progress
+     */
+    class AUSTINUTILS file_sink : public log_sink {
+        std::string path;
+        file_sink_options options;
+        int fd = -1;
+        u64 file_bytes = 0;
+        std::chrono::system_clock::time_point opened;
+        //the files were moved along but the new one could not be opened, fd is still the old one and the open is tried again at retry_at
+        bool rotation_pending = false;
+        std::chrono::system_clock::time_point retry_at;
+
+        std::mutex lock;
+        std::string active;
+        //held while writing to the file, taken before lock is released so writes keep the order the lines arrived in
+        std::mutex io_lock;
+        std::string spare;
+
+        //starts writing to fd, a newly opened path
+        void use(int file);
+
+        void rotate();
+
+        //writes data to the file, rotating first if needed, io_lock must be held
+        void output(std::string_view data);
+
+    public:
+
+        /*
+         * opens path for appending, creating it if needed, throws if it can not be opened
+         * a rotation that can not open the new file is reported on stderr, lines keep going to the old file and the open is retried every second
+         */
+        explicit file_sink(std::string path, file_sink_options options = file_sink_options());
+
+        file_sink(const file_sink&) = delete;
+
+        file_sink& operator =(const file_sink&) = delete;
+
+        //writes out what is buffered and closes the file
+        ~file_sink() override;
+
+        void write(LOG_TYPE type, std::string_view lines) override;
+
+        void flush() override;
+
+        NODISCARD const std::string& file() const;
+    };
+
+    //appends s encoded as UTF-8, wchar_t is UTF-16 on windows and UTF-32 everywhere else
+    extern AUSTINUTILS void append_utf8(std::string& out, std::wstring_view s);
+}
+
+#endif
@@ -0,0 +1,250 @@
+#include "lzcompress.hpp"
+
+#include <bit>
+#include <cstring>
+
+#include "Error.hpp"
+
+
+namespace AustinUtils {
+
+    //the LZ4 block format's limits, the last match starts at least 12 bytes before the end and the last 5 bytes are always literals
+    static constexpr usize min_match = 4;
+    static constexpr usize last_literals = 5;
+    static constexpr usize match_find_limit = 12;
+    static constexpr usize max_offset = 65535;
+    static constexpr u32 hash_bits = 13;
+
+    static u32 read32(const u8* p) {
+        u32 x;
+        std::memcpy(&x, p, sizeof(x));
+        return x;
+    }
+
+    static u64 read64(const u8* p) {
+        u64 x;
+        std::memcpy(&x, p, sizeof(x));
+        return x;
+    }
+
+    static void write32(u8* p, const u32 x) {
+        for (usize i = 0; i < 4; i++) p[i] = cast(x >> (i*8), u8);
+    }
+
+    static u32 load32(const u8* p) {
+        return p[0] | cast(p[1], u32) << 8 | cast(p[2], u32) << 16 | cast(p[3], u32) << 24;
+    }
+
+    static u32 hashPosition(const u8* p) {
+        return (read32(p) * 2654435761u) >> (32 - hash_bits);
+    }
+
+    //how many bytes from p and m are equal, stopping at limit
+    static usize matchLength(const u8* p, const u8* m, const u8* limit) {
+        const u8* start = p;
+        if constexpr (std::endian::native == std::endian::little) {
+            while (p + 8 <= limit) {
+                if (const u64 diff = read64(p) ^ read64(m); diff != 0) return p - start + std::countr_zero(diff) / 8;
+                p += 8;
+                m += 8;
+            }
+        }
+        while (p < limit && *p == *m) {
+            p++;
+            m++;
+        }
+        return p - start;
+    }
+
+    //a length past the 4 bits of the token goes on in bytes of 255 and a final byte below 255
+    static u8* writeLength(u8* op, usize n) {
+        while (n >= 255) {
+            *op++ = 255;
+            n -= 255;
+        }
+        *op++ = cast(n, u8);
+        return op;
+    }
+
+    static u8* writeSequence(u8* op, const u8* literals, const usize literal_len, const usize offset, const usize match_len) {
+        u8* token = op++;
+        *token = cast(std::min<usize>(literal_len, 15) << 4, u8);
+        if (literal_len >= 15) op = writeLength(op, literal_len - 15);
+        std::memcpy(op, literals, literal_len);
+        op += literal_len;
+        if (match_len == 0) return op;
+
+        *op++ = cast(offset & 0xFF, u8);
+        *op++ = cast(offset >> 8, u8);
+        const usize extra = match_len - min_match;
+        *token |= cast(std::min<usize>(extra, 15), u8);
+        if (extra >= 15) op = writeLength(op, extra - 15);
+        return op;
+    }
+
+    usize lz_compress(const void* source, const usize n, void* destination) {
+        const u8* src = static_cast<const u8*>(source);
+        u8* const dst = static_cast<u8*>(destination);
+        u8* op = dst;
+        const u8* anchor = src;
+
+        if (n > match_find_limit) {
+            //positions are kept relative to src, 0 also means empty, which the match check rejects by content or offset
+            u32 table[1 << hash_bits] = {};
+            const u8* const end = src + n;
+            const u8* const match_limit = end - match_find_limit;
+            const u8* const extend_limit = end - last_literals;
+            const u8* ip = src + 1;
+
+            loop {
+                //the step grows the longer nothing matches, so incompressible data is skipped over quickly
+                const u8* match;
+                usize attempts = 1 << 6;
+                loop {
+                    if (ip > match_limit) goto finish;
+                    const u32 h = hashPosition(ip);
+                    match = src + table[h];
+                    table[h] = cast(ip - src, u32);
+                    if (match < ip && cast(ip - match, usize) <= max_offset && read32(match) == read32(ip)) break;
+                    ip += attempts++ >> 6;
+                }
+
+                while (ip > anchor && match > src && ip[-1] == match[-1]) {
+                    ip--;
+                    match--;
+                }
+                const usize length = min_match + matchLength(ip + min_match, match + min_match, extend_limit);
+                op = writeSequence(op, anchor, ip - anchor, ip - match, length);
+                ip += length;
+                anchor = ip;
+                if (ip <= match_limit) table[hashPosition(ip - 2)] = cast(ip - 2 - src, u32);
+            }
+        }
+        finish:
+        op = writeSequence(op, anchor, src + n - anchor, 0, 0);
+        return op - dst;
+    }
+
+    usize lz_decompress(const void* source, const usize n, void* destination, const usize capacity) {
+        const u8* ip = static_cast<const u8*>(source);
+        const u8* const iend = ip + n;
+        u8* const dst = static_cast<u8*>(destination);
+        u8* op = dst;
+        u8* const oend = dst + capacity;
+
+        const auto readLength = [&](usize length) {
+            u8 b;
+            do {
+                if (ip >= iend) throw Exception("Corrupt lz block: it ends inside a length");
+                b = *ip++;
+                length += b;
+            } while (b == 255);
+            return length;
+        };
+
+        while (ip < iend) {
+            const u8 token = *ip++;
+            usize literals = token >> 4;
+            if (literals == 15) literals = readLength(literals);
+            if (literals > cast(iend - ip, usize)) throw Exception("Corrupt lz block: ", literals, " literals but ", iend - ip, " bytes left");
+            if (literals > cast(oend - op, usize)) throw Exception("Corrupt lz block: it decompresses to more than ", capacity, " bytes");
+            std::memcpy(op, ip, literals);
+            ip += literals;
+            op += literals;
+            //the last sequence has no match
+            if (ip == iend) break;
+
+            if (iend - ip < 2) throw Exception("Corrupt lz block: it ends inside an offset");
+            const usize offset = ip[0] | cast(ip[1], usize) << 8;
+            ip += 2;
+            if (offset == 0 || offset > cast(op - dst, usize)) throw Exception("Corrupt lz block: offset ", offset, " at output position ", op - dst);
+            usize length = token & 15;
+            if (length == 15) length = readLength(length);
+            length += min_match;
+            if (length > cast(oend - op, usize)) throw Exception("Corrupt lz block: it decompresses to more than ", capacity, " bytes");
+
+            const u8* match = op - offset;
+            if (offset >= 8 && cast(oend - op, usize) >= length + 8) {
+                //8 bytes at a time may write up to 7 bytes too far, which is still inside dst and overwritten next
+                u8* const stop = op + length;
+                while (op < stop) {
+                    std::memcpy(op, match, 8);
+                    op += 8;
+                    match += 8;
+                }
+                op = stop;
+            } else {
+                //overlapping copies repeat the last offset bytes, which a byte loop does naturally
+                for (usize i = 0; i < length; i++) *op++ = *match++;
+            }
+        }
+        return op - dst;
+    }
+
+    u32 lz_checksum(const void* data, const usize n) {
+        const u8* p = static_cast<const u8*>(data);
+        u64 h = 0x9E3779B97F4A7C15ull ^ n;
+        usize i = 0;
+        for (; i + 8 <= n; i += 8) {
+            u64 x = 0;
+            if constexpr (std::endian::native == std::endian::little) std::memcpy(&x, p + i, 8);
+            else for (usize b = 0; b < 8; b++) x |= cast(p[i+b], u64) << (b*8);
+            h = std::rotl(h ^ x * 0xC2B2AE3D27D4EB4Full, 31) * 0x9E3779B97F4A7C15ull;
+        }
+        for (; i < n; i++) h = (h ^ p[i]) * 0x100000001B3ull;
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        return cast(h, u32);
+    }
+
+    void lz_frame_append(std::string& out, const std::string_view data) {
+        if (data.size() >= 1u << 31) throw Exception("An lz frame holds less than 2GB, got ", data.size(), " bytes");
+        const usize start = out.size();
+        out.resize(start + LZ_FRAME_HEADER + lz_max_compressed_len(data.size()));
+        u8* header = reinterpret_cast<u8*>(out.data() + start);
+        usize block = lz_compress(data.data(), data.size(), header + LZ_FRAME_HEADER);
+        u32 stored = 0;
+        if (block >= data.size()) {
+            std::memcpy(header + LZ_FRAME_HEADER, data.data(), data.size());
+            block = data.size();
+            stored = 1u << 31;
+        }
+        write32(header, LZ_FRAME_MAGIC);
+        write32(header + 4, cast(data.size(), u32));
+        write32(header + 8, cast(block, u32) | stored);
+        write32(header + 12, lz_checksum(data.data(), data.size()));
+        write32(header + 16, lz_checksum(header, 16));
+        out.resize(start + LZ_FRAME_HEADER + block);
+    }
+
+    usize lz_frame_read(const std::string_view in, std::string& out) {
+        if (in.size() < LZ_FRAME_HEADER) return 0;
+        const u8* header = reinterpret_cast<const u8*>(in.data());
+        if (load32(header) != LZ_FRAME_MAGIC) throw Exception("Not an lz frame, the magic number is wrong");
+        //checked before the sizes are trusted, a damaged size must not make the frame look incomplete
+        if (lz_checksum(header, 16) != load32(header + 16)) throw Exception("Corrupt lz frame, the header checksum does not match");
+        const u32 raw = load32(header + 4);
+        const bool stored = load32(header + 8) >> 31;
+        const u32 block = load32(header + 8) & ~(1u << 31);
+        if (raw >= 1u << 31 || (stored && block != raw) || block > lz_max_compressed_len(raw)) throw Exception("Corrupt lz frame header");
+        if (in.size() - LZ_FRAME_HEADER < block) return 0;
+
+        //out is only touched once the frame is known to be good
+        const usize start = out.size();
+        out.resize(start + raw);
+        try {
+            const u8* body = header + LZ_FRAME_HEADER;
+            if (stored) {
+                std::memcpy(out.data() + start, body, raw);
+            } else if (lz_decompress(body, block, out.data() + start, raw) != raw) {
+                throw Exception("Corrupt lz frame, it decompressed to the wrong size");
+            }
+            if (lz_checksum(out.data() + start, raw) != load32(header + 12)) throw Exception("Corrupt lz frame, the checksum does not match");
+        } catch (...) {
+            out.resize(start);
+            throw;
+        }
+        return LZ_FRAME_HEADER + block;
+    }
+}
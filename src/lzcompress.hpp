@@ -0,0 +1,50 @@
+#ifndef LZCOMPRESS_HPP
+#define LZCOMPRESS_HPP
+
+#include <string>
+#include <string_view>
+#include "misc.hpp"
+
+#define AUSTINUTILS __declspec(dllexport)
+
+/*
+ * a fast general purpose byte compressor writing the LZ4 block format, one hash probe per position and no entropy coding,
+ * made for text like log lines where it runs at hundreds of MB/s
+ * frames wrap a compressed block with its sizes and a checksum, each frame decodes on its own
+ */
+
+namespace AustinUtils {
+
+    //the most bytes lz_compress can write for n input bytes
+    NODISCARD constexpr usize lz_max_compressed_len(const usize n) {
+        return n + n/255 + 16;
+    }
+
+    //compresses the n bytes at src into dst, which must have room for lz_max_compressed_len(n) bytes, returns the bytes written
+    extern AUSTINUTILS usize lz_compress(const void* src, usize n, void* dst);
+
+    //decompresses n bytes of lz_compress output into dst, throws if they are corrupt or would need more than capacity bytes, returns the bytes written
+    extern AUSTINUTILS usize lz_decompress(const void* src, usize n, void* dst, usize capacity);
+
+    //a 32 bit checksum for catching corruption, not for security
+    NODISCARD extern AUSTINUTILS u32 lz_checksum(const void* data, usize n);
+
+    /*
+     * a frame is a 20 byte header and a block, all little endian:
+     * u32 magic "AULZ", u32 raw size, u32 block size with the top bit set if the block is stored uncompressed, u32 lz_checksum of the raw bytes,
+     * u32 lz_checksum of the 16 header bytes before it
+     */
+    static constexpr u32 LZ_FRAME_MAGIC = 0x5A4C5541;
+    static constexpr usize LZ_FRAME_HEADER = 20;
+
+    //appends one frame holding data to out, data that does not compress is stored as it is
+    extern AUSTINUTILS void lz_frame_append(std::string& out, std::string_view data);
+
+    /*
+     * appends the decompressed contents of the frame at the start of in to out and returns the frame's size in bytes
+     * returns 0 if in holds only the start of a frame, throws if the frame is corrupt, leaving out as it was
+     */
+    extern AUSTINUTILS usize lz_frame_read(std::string_view in, std::string& out);
+}
+
+#endif
@@ -0,0 +1,224 @@
+#include "metrics.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <thread>
+
+#include "Error.hpp"
+#include "logsink.hpp"
+#include "str.hpp"
+
+
+namespace AustinUtils {
+
+    usize metric_shard_count() {
+        static const usize count = std::min<usize>(std::bit_ceil(std::max(1u, std::thread::hardware_concurrency())), 64);
+        return count;
+    }
+
+    usize metric_shard() {
+        static std::atomic<usize> next = 0;
+        static thread_local const usize shard = next.fetch_add(1, std::memory_order_relaxed) & (metric_shard_count() - 1);
+        return shard;
+    }
+
+
+    metric_counter::metric_counter() : shards(std::make_unique<shard[]>(metric_shard_count())) {}
+
+    u64 metric_counter::value() const {
+        u64 total = 0;
+        for (usize i = 0; i < metric_shard_count(); i++) total += shards[i].value.load(std::memory_order_relaxed);
+        return total;
+    }
+
+
+    u64 histogram_snapshot::percentile(const double p) const {
+        if (count == 0) return 0;
+        const u64 rank = std::clamp<u64>(cast(std::ceil(p / 100 * cast(count, double)), u64), 1, count);
+        u64 seen = 0;
+        for (usize i = 0; i < buckets.size(); i++) {
+            seen += buckets[i];
+            if (seen >= rank) return metric_histogram::highest(i);
+        }
+        return metric_histogram::highest(buckets.size() - 1);
+    }
+
+    double histogram_snapshot::mean() const {
+        return count == 0 ? 0 : cast(sum, double) / cast(count, double);
+    }
+
+    void histogram_snapshot::merge(const histogram_snapshot& other) {
+        if (buckets.size() < other.buckets.size()) buckets.resize(other.buckets.size(), 0);
+        for (usize i = 0; i < other.buckets.size(); i++) buckets[i] += other.buckets[i];
+        count += other.count;
+        sum += other.sum;
+    }
+
+
+    metric_histogram::metric_histogram() : shards(std::make_unique<shard[]>(metric_shard_count())) {}
+
+    histogram_snapshot metric_histogram::snapshot() const {
+        histogram_snapshot s;
+        s.buckets.assign(bucket_count, 0);
+        for (usize i = 0; i < metric_shard_count(); i++) {
+            const shard& sh = shards[i];
+            for (usize b = 0; b < bucket_count; b++) s.buckets[b] += sh.buckets[b].load(std::memory_order_relaxed);
+            s.sum += sh.sum.load(std::memory_order_relaxed);
+        }
+        for (const u64 c : s.buckets) s.count += c;
+        return s;
+    }
+
+
+    static bool validName(const std::string_view name) {
+        if (name.empty()) return false;
+        for (usize i = 0; i < name.size(); i++) {
+            const char c = name[i];
+            const bool letter = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':';
+            if (!letter && !(i > 0 && c >= '0' && c <= '9')) return false;
+        }
+        return true;
+    }
+
+    metric_registry::entry& metric_registry::find(const std::string_view name, const std::string_view help, const METRIC_KIND kind) {
+        const usize brace = name.find('{');
+        const std::string_view base = name.substr(0, brace);
+        std::string_view labels;
+        if (brace != std::string_view::npos) {
+            if (name.back() != '}') throw Exception("Invalid metric name ", name, ", the labels do not end in '}'");
+            labels = name.substr(brace + 1, name.size() - brace - 2);
+        }
+        if (!validName(base)) throw Exception("Invalid metric name ", name);
+
+        std::lock_guard guard(lock);
+        auto f = families.find(base);
+        if (f == families.end()) f = families.emplace(std::string(base), family{kind, std::string(help), {}}).first;
+        if (f->second.kind != kind) throw Exception("The metric ", base, " already exists as a different kind of metric");
+        if (f->second.help.empty()) f->second.help = help;
+
+        auto e = f->second.metrics.find(labels);
+        if (e == f->second.metrics.end()) {
+            entry created{kind, null, null, null};
+            if (kind == METRIC_COUNTER) created.counter = std::make_unique<metric_counter>();
+            else if (kind == METRIC_GAUGE) created.gauge = std::make_unique<metric_gauge>();
+            else created.histogram = std::make_unique<metric_histogram>();
+            e = f->second.metrics.emplace(std::string(labels), std::move(created)).first;
+        }
+        return e->second;
+    }
+
+    metric_counter& metric_registry::counter(const std::string_view name, const std::string_view help) {
+        return *find(name, help, METRIC_COUNTER).counter;
+    }
+
+    metric_gauge& metric_registry::gauge(const std::string_view name, const std::string_view help) {
+        return *find(name, help, METRIC_GAUGE).gauge;
+    }
+
+    metric_histogram& metric_registry::histogram(const std::string_view name, const std::string_view help) {
+        return *find(name, help, METRIC_HISTOGRAM).histogram;
+    }
+
+    //name{labels,extra} with the braces left out when there are no labels at all
+    static void appendSeries(std::string& out, const std::string_view name, const std::string_view suffix, const std::string_view labels,
+                             const std::string_view extra = {}) {
+        out.append(name).append(suffix);
+        if (labels.empty() && extra.empty()) return;
+        out.push_back('{');
+        out.append(labels);
+        if (!labels.empty() && !extra.empty()) out.push_back(',');
+        out.append(extra);
+        out.push_back('}');
+    }
+
+    static void appendValue(std::string& out, const double v) {
+        if (std::isnan(v)) {
+            out.append(" NaN\n");
+        } else if (std::isinf(v)) {
+            out.append(v > 0 ? " +Inf\n" : " -Inf\n");
+        } else {
+            char buffer[32];
+            const std::to_chars_result r = std::to_chars(buffer, buffer + sizeof(buffer), v, std::chars_format::general);
+            out.push_back(' ');
+            out.append(buffer, r.ptr);
+            out.push_back('\n');
+        }
+    }
+
+    static void appendValue(std::string& out, const u64 v) {
+        char buffer[24];
+        const std::to_chars_result r = std::to_chars(buffer, buffer + sizeof(buffer), v);
+        out.push_back(' ');
+        out.append(buffer, r.ptr);
+        out.push_back('\n');
+    }
+
+    //a help text with '\' and newlines escaped
+    static void appendHelp(std::string& out, const std::string_view help) {
+        for (const char c : help) {
+            if (c == '\\') out.append("\\\\");
+            else if (c == '\n') out.append("\\n");
+            else out.push_back(c);
+        }
+    }
+
+    void metric_registry::prometheus(std::string& out) const {
+        static constexpr std::pair<double, std::string_view> quantiles[] = {
+            {50, "quantile=\"0.5\""}, {90, "quantile=\"0.9\""}, {99, "quantile=\"0.99\""}, {99.9, "quantile=\"0.999\""}
+        };
+
+        std::lock_guard guard(lock);
+        for (const auto& [name, f] : families) {
+            if (!f.help.empty()) {
+                out.append("# HELP ").append(name).push_back(' ');
+                appendHelp(out, f.help);
+                out.push_back('\n');
+            }
+            out.append("# TYPE ").append(name);
+            out.append(f.kind == METRIC_COUNTER ? " counter\n" : f.kind == METRIC_GAUGE ? " gauge\n" : " summary\n");
+
+            for (const auto& [labels, e] : f.metrics) {
+                if (e.kind == METRIC_COUNTER) {
+                    appendSeries(out, name, "", labels);
+                    appendValue(out, e.counter->value());
+                } else if (e.kind == METRIC_GAUGE) {
+                    appendSeries(out, name, "", labels);
+                    appendValue(out, e.gauge->value());
+                } else {
+                    const histogram_snapshot s = e.histogram->snapshot();
+                    for (const auto& [p, label] : quantiles) {
+                        appendSeries(out, name, "", labels, label);
+                        appendValue(out, s.percentile(p));
+                    }
+                    appendSeries(out, name, "_sum", labels);
+                    appendValue(out, s.sum);
+                    appendSeries(out, name, "_count", labels);
+                    appendValue(out, s.count);
+                }
+            }
+        }
+    }
+
+    void metric_registry::prometheus(str& out) const {
+        std::string text;
+        prometheus(text);
+        out.append(std::string_view(text));
+    }
+
+    str metric_registry::prometheus() const {
+        str out;
+        prometheus(out);
+        return out;
+    }
+
+    void metric_registry::write(log_sink& sink, const LOG_TYPE type) const {
+        std::string text;
+        prometheus(text);
+        if (!text.empty()) sink.write(type, text);
+    }
+
+    metric_registry& metric_registry::global() {
+        static metric_registry registry;
+        return registry;
+    }
+}
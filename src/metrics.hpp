@@ -0,0 +1,210 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "misc.hpp"
+
+#define AUSTINUTILS __declspec(dllexport)
+
+/*
+ * counters, gauges and latency histograms cheap enough for hot paths
+ * counters and histograms are split into cache line sized shards, each thread adds to its own shard with relaxed atomics,
+ * so recording is wait-free and threads do not fight over cache lines, the shards are only summed when a snapshot is taken
+ */
+
+namespace AustinUtils {
+
+    enum LOG_TYPE : int;
+    class log_sink;
+    class str;
+
+    //how many shards every counter and histogram has, the number of cores rounded up to a power of two, at most 64
+    NODISCARD extern AUSTINUTILS usize metric_shard_count();
+
+    //the shard of the calling thread, threads are handed shards in turn the first time they record
+    NODISCARD extern AUSTINUTILS usize metric_shard();
+
+    class AUSTINUTILS metric_counter {
+        struct alignas(64) shard {
+            std::atomic<u64> value = 0;
+        };
+
+        std::unique_ptr<shard[]> shards;
+
+    public:
+        metric_counter();
+
+        void add(const u64 n = 1) {
+            shards[metric_shard()].value.fetch_add(n, std::memory_order_relaxed);
+        }
+
+        //the sum of every shard, additions made while summing may or may not be counted
+        NODISCARD u64 value() const;
+    };
+
+    //a value that goes up and down, set is wait-free, add is a compare and swap loop
+    class AUSTINUTILS metric_gauge {
+        std::atomic<double> current = 0;
+
+    public:
+        void set(const double value) {
+            current.store(value, std::memory_order_relaxed);
+        }
+
+        void add(const double n) {
+            double old = current.load(std::memory_order_relaxed);
+            while (!current.compare_exchange_weak(old, old + n, std::memory_order_relaxed)) {}
+        }
+
+        NODISCARD double value() const {
+            return current.load(std::memory_order_relaxed);
+        }
+    };
+
+    /*
+     * the counts of a histogram summed over its shards, bucket i holds the values metric_histogram::lowest(i) to metric_histogram::highest(i)
+     * each bucket is read atomically, but values recorded while the snapshot is taken may be in some buckets and not yet in sum
+     */
+    struct AUSTINUTILS histogram_snapshot {
+        std::vector<u64> buckets;
+        u64 count = 0;
+        u64 sum = 0;
+
+        //the value p percent of the values are at or below, as the highest value of its bucket, 0 if nothing was recorded
+        NODISCARD u64 percentile(double p) const;
+
+        NODISCARD double mean() const;
+
+        //adds the counts of other, for combining histograms of several processes or time windows
+        void merge(const histogram_snapshot& other);
+    };
+
+    /*
+     * counts u64 values (usually nanoseconds) in log-linear buckets the way HDR histograms do,
+     * every power of two is split into 16 buckets, so a value is known to within 1/16 of itself, values below 32 exactly
+     */
+    class AUSTINUTILS metric_histogram {
+    public:
+        static constexpr u32 sub_bits = 4;
+        static constexpr u32 sub_count = 1 << sub_bits;
+        static constexpr usize bucket_count = (64 - sub_bits + 1) * sub_count;
+
+        NODISCARD static constexpr usize bucket(const u64 v) {
+            const u32 magnitude = std::bit_width(v);
+            if (magnitude <= sub_bits + 1) return v;
+            const u32 shift = magnitude - sub_bits - 1;
+            return shift * sub_count + (v >> shift);
+        }
+
+        NODISCARD static constexpr u64 lowest(const usize b) {
+            if (b < 2 * sub_count) return b;
+            const u32 shift = cast(b / sub_count - 1, u32);
+            return cast(b % sub_count + sub_count, u64) << shift;
+        }
+
+        NODISCARD static constexpr u64 highest(const usize b) {
+            if (b < 2 * sub_count) return b;
+            const u32 shift = cast(b / sub_count - 1, u32);
+            return lowest(b) + ((u64(1) << shift) - 1);
+        }
+
+    private:
+        struct alignas(64) shard {
+            std::atomic<u64> sum = 0;
+            std::atomic<u64> buckets[bucket_count] = {};
+        };
+
+        std::unique_ptr<shard[]> shards;
+
+    public:
+        metric_histogram();
+
+        void record(const u64 v) {
+            shard& s = shards[metric_shard()];
+            s.buckets[bucket(v)].fetch_add(1, std::memory_order_relaxed);
+            s.sum.fetch_add(v, std::memory_order_relaxed);
+        }
+
+        //records d in nanoseconds
+        template<typename Rep, typename Period>
+        void record(const std::chrono::duration<Rep, Period> d) {
+            const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+            record(ns < 0 ? 0 : cast(ns, u64));
+        }
+
+        NODISCARD histogram_snapshot snapshot() const;
+    };
+
+    /*
+     * named metrics that can be exported together in the Prometheus text format
+     * a name is a Prometheus metric name, optionally followed by labels: "http_requests_total{method=\"GET\",code=\"200\"}",
+     * metrics with the same name and different labels form one family and must be of the same kind
+     * looking a metric up takes a lock, keep the reference it returns, it stays valid as long as the registry
+     */
+    class AUSTINUTILS metric_registry {
+        enum METRIC_KIND {
+            METRIC_COUNTER,
+            METRIC_GAUGE,
+            METRIC_HISTOGRAM
+        };
+
+        struct entry {
+            METRIC_KIND kind;
+            std::unique_ptr<metric_counter> counter;
+            std::unique_ptr<metric_gauge> gauge;
+            std::unique_ptr<metric_histogram> histogram;
+        };
+
+        struct family {
+            METRIC_KIND kind;
+            std::string help;
+            //keyed by the labels without braces, "" for none
+            std::map<std::string, entry, std::less<>> metrics;
+        };
+
+        mutable std::mutex lock;
+        std::map<std::string, family, std::less<>> families;
+
+        entry& find(std::string_view name, std::string_view help, METRIC_KIND kind);
+
+    public:
+        metric_registry() = default;
+
+        metric_registry(const metric_registry&) = delete;
+
+        metric_registry& operator =(const metric_registry&) = delete;
+
+        //the metric called name, created the first time, throws if the name is invalid or already used by another kind of metric
+        metric_counter& counter(std::string_view name, std::string_view help = "");
+
+        metric_gauge& gauge(std::string_view name, std::string_view help = "");
+
+        metric_histogram& histogram(std::string_view name, std::string_view help = "");
+
+        /*
+         * appends every metric in the Prometheus text format, families sorted by name
+         * histograms are written as summaries with the 0.5, 0.9, 0.99 and 0.999 quantiles, _sum and _count
+         */
+        void prometheus(std::string& out) const;
+
+        void prometheus(str& out) const;
+
+        NODISCARD str prometheus() const;
+
+        //writes the Prometheus text to sink as lines of the given level, for example to a logger's sink()
+        void write(log_sink& sink, LOG_TYPE type) const;
+
+        static metric_registry& global();
+    };
+}
+
+#endif
@@ -0,0 +1,202 @@
+#include "parallelstr.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+
+namespace AustinUtils {
+
+    static constexpr usize npos = str::npos;
+
+    //chunks smaller than this cost more to schedule than to search
+    static constexpr usize min_chunk = 1 << 20;
+
+    //a chunk owns the occurrences starting in [begin, end), it reads up to end + pattern length - 1
+    struct chunk_range {
+        usize begin;
+        usize end;
+    };
+
+    struct chunk_result {
+        usize count = 0;
+        usize first = npos;
+        usize last_end = 0;
+        std::vector<usize> positions;
+    };
+
+    static std::vector<chunk_range> splitChunks(const usize n, const usize m, const threadpool& pool) {
+        std::vector<chunk_range> chunks;
+        if (m == 0 || m > n) return chunks;
+
+        //a few chunks per thread so uneven chunks still balance out
+        const usize starts = n - m + 1;
+        const usize count = std::clamp<usize>(starts / min_chunk, 1, (pool.size() + 1) * 4);
+        const usize per = (starts + count - 1) / count;
+        for (usize begin = 0; begin < starts; begin += per) {
+            chunks.push_back({begin, std::min(begin + per, starts)});
+        }
+        return chunks;
+    }
+
+    //returns the first occurrence starting in [from, end)
+    static usize findIn(const std::string_view text, const std::string_view pattern, const usize from, const usize end) {
+        if (from >= end) return npos;
+        const usize pos = text.substr(from, end - from + pattern.size() - 1).find(pattern);
+        return pos == std::string_view::npos ? npos : from + pos;
+    }
+
+    //a greedy left to right scan of one chunk, starting at the chunk's first byte
+    static chunk_result scanChunk(const std::string_view text, const std::string_view pattern, const chunk_range range, const bool collect) {
+        chunk_result ret;
+        for (usize p = findIn(text, pattern, range.begin, range.end); p != npos; p = findIn(text, pattern, p + pattern.size(), range.end)) {
+            if (ret.count++ == 0) ret.first = p;
+            ret.last_end = p + pattern.size();
+            if (collect) ret.positions.push_back(p);
+        }
+        return ret;
+    }
+
+    static std::vector<chunk_result> scanChunks(const std::string_view text, const std::string_view pattern,
+                                                const std::vector<chunk_range>& chunks, const bool collect, threadpool& pool) {
+        std::vector<chunk_result> results(chunks.size());
+        pool.parallel_for(chunks.size(), [&](const usize i) {
+            results[i] = scanChunk(text, pattern, chunks[i], collect);
+        });
+        return results;
+    }
+
+    usize parallel_find(const str& s, const std::string_view pattern, threadpool& pool) {
+        const std::string_view text(s.data(), s.len());
+        const std::vector<chunk_range> chunks = splitChunks(text.size(), pattern.size(), pool);
+
+        //chunks past an occurrence that has already been found can not hold the first one
+        std::atomic<usize> best = npos;
+        pool.parallel_for(chunks.size(), [&](const usize i) {
+            if (chunks[i].begin > best.load(std::memory_order_relaxed)) return;
+            const usize p = findIn(text, pattern, chunks[i].begin, chunks[i].end);
+            usize current = best.load(std::memory_order_relaxed);
+            while (p < current && !best.compare_exchange_weak(current, p, std::memory_order_relaxed)) {}
+        });
+        return best.load();
+    }
+
+    /*
+     * a chunk scanned greedily from its first byte can disagree with the real scan when the previous chunk's last
+     * occurrence runs into it, in that case the real scan is replayed from where it stands until it lands on one of
+     * the chunk's own occurrences, from there on both scans are identical
+     */
+
+    std::vector<usize> parallel_find_all(const str& s, const std::string_view pattern, threadpool& pool) {
+        const std::string_view text(s.data(), s.len());
+        const std::vector<chunk_range> chunks = splitChunks(text.size(), pattern.size(), pool);
+        const std::vector<chunk_result> results = scanChunks(text, pattern, chunks, true, pool);
+
+        std::vector<usize> ret;
+        usize total = 0;
+        for (const chunk_result& r : results) total += r.count;
+        ret.reserve(total);
+
+        usize next_allowed = 0;
+        for (usize c = 0; c < chunks.size(); c++) {
+            const std::vector<usize>& own = results[c].positions;
+            if (own.empty()) continue;
+            if (own.front() >= next_allowed) {
+                ret.insert(ret.end(), own.begin(), own.end());
+                next_allowed = results[c].last_end;
+                continue;
+            }
+
+            usize li = 0;
+            for (usize g = findIn(text, pattern, next_allowed, chunks[c].end); g != npos; g = findIn(text, pattern, g + pattern.size(), chunks[c].end)) {
+                while (li < own.size() && own[li] < g) li++;
+                if (li < own.size() && own[li] == g) {
+                    ret.insert(ret.end(), own.begin() + li, own.end());
+                    next_allowed = results[c].last_end;
+                    break;
+                }
+                ret.push_back(g);
+                next_allowed = g + pattern.size();
+            }
+        }
+        return ret;
+    }
+
+    usize parallel_count(const str& s, const std::string_view pattern, threadpool& pool) {
+        const std::string_view text(s.data(), s.len());
+        const std::vector<chunk_range> chunks = splitChunks(text.size(), pattern.size(), pool);
+        const std::vector<chunk_result> results = scanChunks(text, pattern, chunks, false, pool);
+
+        //the same merge as parallel_find_all, but the chunk's own scan is replayed instead of stored
+        usize total = 0;
+        usize next_allowed = 0;
+        for (usize c = 0; c < chunks.size(); c++) {
+            const chunk_result& r = results[c];
+            if (r.count == 0) continue;
+            if (r.first >= next_allowed) {
+                total += r.count;
+                next_allowed = r.last_end;
+                continue;
+            }
+
+            usize own = r.first;
+            usize skipped = 0;
+            for (usize g = findIn(text, pattern, next_allowed, chunks[c].end); g != npos; g = findIn(text, pattern, g + pattern.size(), chunks[c].end)) {
+                while (own != npos && own < g) {
+                    skipped++;
+                    own = findIn(text, pattern, own + pattern.size(), chunks[c].end);
+                }
+                if (own == g) {
+                    total += r.count - skipped;
+                    next_allowed = r.last_end;
+                    break;
+                }
+                total++;
+                next_allowed = g + pattern.size();
+            }
+        }
+        return total;
+    }
+
+    str& parallel_replace_all(str& s, const std::string_view from, const std::string_view to, const usize max, threadpool& pool) {
+        if (from.empty() || max == 0) return s;
+
+        //pass one, find every occurrence
+        std::vector<usize> positions = parallel_find_all(s, from, pool);
+        if (positions.size() > max) positions.resize(max);
+        if (positions.empty()) return s;
+
+        const usize k = positions.size();
+        const usize n = s.len();
+        const usize m = from.size();
+        const usize t = to.size();
+        const usize new_len = n - k*m + k*t;
+        const char* src = s.data();
+
+        //pass two, every piece has a known destination so the copies are independent
+        str ret;
+        ret.resize_and_overwrite(new_len, [&](char* dst, usize) {
+            const usize groups = std::min(k, (pool.size() + 1) * 4);
+            const usize per = (k + groups - 1) / groups;
+            pool.parallel_for(groups, [&](const usize gi) {
+                const usize a = gi * per;
+                const usize b = std::min(a + per, k);
+                for (usize i = a; i < b; i++) {
+                    const usize src_begin = i == 0 ? 0 : positions[i-1] + m;
+                    const usize dst_begin = src_begin - i*m + i*t;
+                    const usize gap = positions[i] - src_begin;
+                    std::memcpy(dst + dst_begin, src + src_begin, gap);
+                    std::memcpy(dst + dst_begin + gap, to.data(), t);
+                }
+                if (b == k && a < b) {
+                    const usize src_begin = positions[k-1] + m;
+                    std::memcpy(dst + src_begin - k*m + k*t, src + src_begin, n - src_begin);
+                }
+            });
+            return new_len;
+        });
+
+        s = std::move(ret);
+        return s;
+    }
+}
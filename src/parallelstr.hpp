@@ -0,0 +1,38 @@
+#ifndef PARALLELSTR_HPP
+#define PARALLELSTR_HPP
+
+#include <string_view>
+#include <vector>
+#include "misc.hpp"
+#include "str.hpp"
+#include "threadpool.hpp"
+
+#define AUSTINUTILS __declspec(dllexport)
+
+/*
+ * multithreaded searching for very large strings
+ * the string is split into chunks that overlap by the pattern length and searched on a thread pool,
+ * results are merged in chunk order so they are always the same as a single threaded left to right scan,
+ * occurrences never overlap, like str::replace_all
+ */
+
+namespace AustinUtils {
+
+    //returns the position of the first occurrence of pattern, or str::npos
+    NODISCARD extern AUSTINUTILS usize parallel_find(const str& s, std::string_view pattern, threadpool& pool = threadpool::global());
+
+    //returns the position of every non-overlapping occurrence of pattern, in order
+    NODISCARD extern AUSTINUTILS std::vector<usize> parallel_find_all(const str& s, std::string_view pattern, threadpool& pool = threadpool::global());
+
+    //counts the non-overlapping occurrences of pattern
+    NODISCARD extern AUSTINUTILS usize parallel_count(const str& s, std::string_view pattern, threadpool& pool = threadpool::global());
+
+    /*
+     * replaces up to max non-overlapping occurrences of from with to
+     * the first pass finds every occurrence, the second sizes the result exactly and scatters the pieces into it in parallel
+     */
+    extern AUSTINUTILS str& parallel_replace_all(str& s, std::string_view from, std::string_view to, usize max = str::npos,
+                                                 threadpool& pool = threadpool::global());
+}
+
+#endif
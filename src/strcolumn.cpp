@@ -0,0 +1,156 @@
+#include "strcolumn.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+#include "Error.hpp"
+#include "trace.hpp"
+
+
+namespace AustinUtils {
+
+    usize str_column::size() const {
+        return offsets.size() - 1;
+    }
+
+    bool str_column::empty() const {
+        return size() == 0;
+    }
+
+    usize str_column::byte_size() const {
+        return bytes.size();
+    }
+
+    void str_column::reserve(const usize strings, const usize bytes) {
+        offsets.reserve(strings + 1);
+        this->bytes.reserve(bytes);
+    }
+
+    void str_column::clear() {
+        bytes.clear();
+        offsets.assign(1, 0);
+    }
+
+    void str_column::push_back(const std::string_view s) {
+        bytes.insert(bytes.end(), s.begin(), s.end());
+        offsets.push_back(bytes.size());
+    }
+
+    void str_column::pop_back() {
+        if (empty()) throw Exception("Cannot pop the back of an empty str_column");
+        offsets.pop_back();
+        bytes.resize(offsets.back());
+    }
+
+    std::string_view str_column::at(const usize i) const {
+        if (i >= size()) throw Exception("Cannot access entry ", i, " of a str_column of ", size());
+        return (*this)[i];
+    }
+
+    std::string_view str_column::back() const {
+        if (empty()) throw Exception("Cannot access the back of an empty str_column");
+        return (*this)[size()-1];
+    }
+
+    str str_column::get(const usize i) const {
+        return str(at(i));
+    }
+
+    usize str_column::find(const std::string_view s, const usize begin) const {
+        for (usize i = begin; i < size(); i++) {
+            if ((*this)[i] == s) return i;
+        }
+        return str::npos;
+    }
+
+    std::vector<usize> str_column::sort_order() const {
+        std::vector<usize> order(size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [this](const usize a, const usize b) {
+            return (*this)[a] < (*this)[b];
+        });
+        return order;
+    }
+
+    void str_column::permute(const std::vector<usize>& order) {
+        usize total = 0;
+        for (const usize i : order) total += at(i).size();
+
+        std::vector<char> new_bytes(total);
+        std::vector<u64> new_offsets;
+        new_offsets.reserve(order.size() + 1);
+        new_offsets.push_back(0);
+        for (const usize i : order) {
+            const std::string_view s = (*this)[i];
+            if (!s.empty()) std::memcpy(new_bytes.data() + new_offsets.back(), s.data(), s.size());
+            new_offsets.push_back(new_offsets.back() + s.size());
+        }
+        bytes = std::move(new_bytes);
+        offsets = std::move(new_offsets);
+    }
+
+    void str_column::sort() {
+        permute(sort_order());
+    }
+
+    usize str_column::hash(const usize i) const {
+        //djb2, the same as std::hash<str>
+        usize hash = 5381;
+        for (const char c : at(i)) {
+            hash = ((hash << 5) + hash) + c;
+        }
+        return hash;
+    }
+
+    std::vector<usize> str_column::hashes() const {
+        //one pass over the byte buffer, restarting the hash at every offset
+        std::vector<usize> ret(size());
+        usize i = 0;
+        for (usize e = 0; e < size(); e++) {
+            usize hash = 5381;
+            for (const usize end = offsets[e+1]; i < end; i++) {
+                hash = ((hash << 5) + hash) + bytes[i];
+            }
+            ret[e] = hash;
+        }
+        return ret;
+    }
+
+    std::vector<str> str_column::toVector() const {
+        std::vector<str> ret;
+        ret.reserve(size());
+        for (usize i = 0; i < size(); i++) ret.emplace_back((*this)[i]);
+        return ret;
+    }
+
+    void split(const std::string_view s, const std::string_view delimiter, str_column& out, const usize max) {
+        AUSTINUTILS_TRACE_SPAN("split", "austinutils");
+        if (delimiter.empty()) {
+            if (!s.empty()) out.push_back(s);
+            return;
+        }
+        usize pos;
+        usize start = 0;
+        usize tokens = 0;
+        while ((pos = s.find(delimiter, start)) != std::string_view::npos && tokens < max-1) {
+            out.push_back(s.substr(start, pos-start));
+            tokens++;
+            start = pos + delimiter.size();
+        }
+        if (start < s.size()) out.push_back(s.substr(start));
+    }
+
+    void tokenize(const std::string_view s, const std::string_view delimiters, str_column& out) {
+        bool is_delimiter[256] = {};
+        for (const char c : delimiters) is_delimiter[cast(c, u8)] = true;
+
+        usize start = 0;
+        for (usize i = 0; i <= s.size(); i++) {
+            if (i == s.size() || is_delimiter[cast(s[i], u8)]) {
+                if (i > start) out.push_back(s.substr(start, i-start));
+                start = i+1;
+            }
+        }
+    }
+}
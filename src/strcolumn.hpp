@@ -0,0 +1,129 @@
+#ifndef STRCOLUMN_HPP
+#define STRCOLUMN_HPP
+
+#include <string_view>
+#include <vector>
+#include "misc.hpp"
+#include "str.hpp"
+
+#define AUSTINUTILS __declspec(dllexport)
+
+/*
+ * a column of strings stored back to back in one byte buffer plus an array of offsets
+ * appending never allocates per string and scanning the column walks memory in order,
+ * entries are handed out as std::string_view, which stay valid until the column is modified
+ */
+
+namespace AustinUtils {
+
+    class AUSTINUTILS str_column {
+        std::vector<char> bytes;
+        //entry i is bytes[offsets[i], offsets[i+1])
+        std::vector<u64> offsets = {0};
+
+    public:
+
+        class iterator {
+            const str_column* column;
+            usize index;
+
+        public:
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+
+            iterator(const str_column* column, const usize index) : column(column), index(index) {}
+
+            std::string_view operator *() const {
+                return (*column)[index];
+            }
+
+            iterator& operator ++() {
+                index++;
+                return *this;
+            }
+
+            iterator operator ++(int) {
+                iterator ret = *this;
+                index++;
+                return ret;
+            }
+
+            bool operator ==(const iterator& other) const {
+                return index == other.index;
+            }
+        };
+
+        str_column() = default;
+
+        //copies every string of an iterable of anything convertible to std::string_view
+        template<typename T>
+        requires Iterable<T>
+        explicit str_column(const T& strings) {
+            for (const auto& s : strings) push_back(s);
+        }
+
+        NODISCARD usize size() const;
+
+        NODISCARD bool empty() const;
+
+        //the bytes every entry takes up together
+        NODISCARD usize byte_size() const;
+
+        void reserve(usize strings, usize bytes);
+
+        void clear();
+
+        void push_back(std::string_view s);
+
+        void pop_back();
+
+        //returns entry i without bounds checking
+        NODISCARD std::string_view operator [](const usize i) const {
+            return {bytes.data() + offsets[i], offsets[i+1] - offsets[i]};
+        }
+
+        //returns entry i, throws if i is out of range
+        NODISCARD std::string_view at(usize i) const;
+
+        NODISCARD std::string_view back() const;
+
+        //copies entry i into a new str
+        NODISCARD str get(usize i) const;
+
+        //returns the index of the first entry equal to s, or str::npos
+        NODISCARD usize find(std::string_view s, usize begin = 0) const;
+
+        //returns the indices of the entries in sorted order, equal entries keep their order
+        NODISCARD std::vector<usize> sort_order() const;
+
+        //rearranges the entries so entry i becomes the old entry order[i], order may repeat or drop entries
+        void permute(const std::vector<usize>& order);
+
+        //sorts the entries, by computing sort_order and moving every byte once
+        void sort();
+
+        //hashes every entry, the same values std::hash<str> gives for an equal str
+        NODISCARD std::vector<usize> hashes() const;
+
+        NODISCARD usize hash(usize i) const;
+
+        //copies every entry into its own str
+        NODISCARD std::vector<str> toVector() const;
+
+        NODISCARD iterator begin() const {
+            return {this, 0};
+        }
+
+        NODISCARD iterator end() const {
+            return {this, size()};
+        }
+    };
+
+    //splits s at each delimiter into out, the same way str::split does, the tokens are appended to out
+    extern AUSTINUTILS void split(std::string_view s, std::string_view delimiter, str_column& out, usize max = str::npos);
+
+    //appends every non-empty run of chars not in delimiters to out
+    extern AUSTINUTILS void tokenize(std::string_view s, std::string_view delimiters, str_column& out);
+}
+
+#endif
@@ -0,0 +1,362 @@
+#include "strcompress.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Error.hpp"
+
+
+namespace AustinUtils {
+
+    //the bytes of training sample used, more mostly costs time without finding better symbols
+    static constexpr usize sample_bytes = 1 << 15;
+    static constexpr usize generations = 5;
+
+    //the ids training counts with, table codes first, then every literal byte
+    static constexpr usize literal_base = 256;
+    static constexpr usize id_count = 512;
+
+    static u64 loadBytes(const char* p, const usize remaining) {
+        u64 word = 0;
+        std::memcpy(&word, p, std::min<usize>(remaining, 8));
+        return word;
+    }
+
+    static u64 lowBytes(const usize n) {
+        return n >= 8 ? ~0ULL : (1ULL << n*8) - 1;
+    }
+
+    //finds the longest symbol at p, returns (length << 8) | code
+    static u16 longestMatch(const std::vector<u64>& symbols, const std::vector<u8>& lengths, const std::vector<u16>& short_codes,
+                            const std::vector<u16>& byte_codes, const std::vector<u32>& bucket_start, const std::vector<u8>& long_codes,
+                            const char* p, const usize remaining) {
+        if (remaining < 2) return byte_codes[cast(p[0], u8)];
+        const u64 word = loadBytes(p, remaining);
+        const usize key = word & 0xFFFF;
+        for (u32 j = bucket_start[key]; j < bucket_start[key+1]; j++) {
+            const u8 code = long_codes[j];
+            const usize len = lengths[code];
+            if (len <= remaining && (word & lowBytes(len)) == symbols[code]) return cast(len << 8 | code, u16);
+        }
+        return short_codes[key];
+    }
+
+    symbol_table::symbol_table() : symbol_table(std::vector<std::pair<u64, u8>>()) {}
+
+    symbol_table::symbol_table(const std::vector<std::pair<u64, u8>>& chosen) {
+        //longest first, so the buckets come out longest first too
+        std::vector<std::pair<u64, u8>> sorted = chosen;
+        std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+            return a.second != b.second ? a.second > b.second : a.first < b.first;
+        });
+        if (sorted.size() > MAX_SYMBOLS) sorted.resize(MAX_SYMBOLS);
+
+        for (const auto& [value, len] : sorted) {
+            symbols.push_back(value);
+            lengths.push_back(len);
+        }
+
+        byte_codes.assign(256, cast(1 << 8 | ESCAPE, u16));
+        for (usize c = 0; c < symbols.size(); c++) {
+            if (lengths[c] == 1) byte_codes[symbols[c]] = cast(1 << 8 | c, u16);
+        }
+        short_codes.resize(1 << 16);
+        for (usize key = 0; key < short_codes.size(); key++) short_codes[key] = byte_codes[key & 0xFF];
+        for (usize c = 0; c < symbols.size(); c++) {
+            if (lengths[c] == 2) short_codes[symbols[c]] = cast(2 << 8 | c, u16);
+        }
+
+        bucket_start.assign((1 << 16) + 1, 0);
+        for (usize c = 0; c < symbols.size(); c++) {
+            if (lengths[c] >= 3) bucket_start[(symbols[c] & 0xFFFF) + 1]++;
+        }
+        for (usize key = 0; key < 1 << 16; key++) bucket_start[key+1] += bucket_start[key];
+        long_codes.resize(bucket_start.back());
+        std::vector<u32> fill(bucket_start.begin(), bucket_start.end() - 1);
+        for (usize c = 0; c < symbols.size(); c++) {
+            if (lengths[c] >= 3) long_codes[fill[symbols[c] & 0xFFFF]++] = cast(c, u8);
+        }
+    }
+
+    symbol_table symbol_table::train(const std::vector<std::string_view>& sample) {
+        //spread the sample over the whole input so a sorted input still trains on every kind of string
+        usize total = 0;
+        for (const std::string_view s : sample) total += s.size();
+        const usize stride = std::max<usize>(1, (total + sample_bytes - 1) / sample_bytes);
+        std::vector<std::string_view> used;
+        usize used_bytes = 0;
+        for (usize i = 0; i < sample.size() && used_bytes < sample_bytes; i += stride) {
+            used.push_back(sample[i].substr(0, sample_bytes - used_bytes));
+            used_bytes += used.back().size();
+        }
+
+        symbol_table table;
+        std::vector<u32> count1(id_count);
+        std::vector<u32> count2(id_count * id_count);
+
+        for (usize gen = 0; gen < generations; gen++) {
+            std::fill(count1.begin(), count1.end(), 0);
+            std::fill(count2.begin(), count2.end(), 0);
+
+            //compress the sample with the current table and count how often every symbol and every pair of symbols is used
+            for (const std::string_view s : used) {
+                usize prev = id_count;
+                for (usize pos = 0; pos < s.size();) {
+                    const u16 match = longestMatch(table.symbols, table.lengths, table.short_codes, table.byte_codes,
+                                                   table.bucket_start, table.long_codes, s.data() + pos, s.size() - pos);
+                    const u8 code = match & 0xFF;
+                    const usize len = match >> 8;
+                    const usize id = code == ESCAPE ? literal_base + cast(s[pos], u8) : code;
+                    count1[id]++;
+                    //the first byte on its own stays a candidate, in case the longer symbol does not survive
+                    if (len > 1) count1[literal_base + cast(s[pos], u8)]++;
+                    if (prev != id_count) count2[prev * id_count + id]++;
+                    prev = id;
+                    pos += len;
+                }
+            }
+
+            const auto symbolOf = [&](const usize id) -> std::pair<u64, u8> {
+                if (id >= literal_base) return {id - literal_base, 1};
+                return {table.symbols[id], table.lengths[id]};
+            };
+
+            //every used symbol and every concatenation of two neighbours is a candidate, worth the bytes it would cover
+            struct candidate {
+                u64 value;
+                u8 len;
+                u64 gain;
+            };
+            std::vector<candidate> candidates;
+            for (usize a = 0; a < id_count; a++) {
+                if (count1[a] == 0) continue;
+                const auto [va, la] = symbolOf(a);
+                candidates.push_back({va, la, cast(count1[a], u64) * la});
+                if (la == MAX_SYMBOL_LENGTH) continue;
+                for (usize b = 0; b < id_count; b++) {
+                    const u32 n = count2[a * id_count + b];
+                    if (n == 0) continue;
+                    const auto [vb, lb] = symbolOf(b);
+                    const u8 len = cast(std::min<usize>(la + lb, MAX_SYMBOL_LENGTH), u8);
+                    const u64 value = (va | vb << la*8) & lowBytes(len);
+                    candidates.push_back({value, len, cast(n, u64) * len});
+                }
+            }
+
+            //the same symbol can come from several places, merge them before ranking
+            std::sort(candidates.begin(), candidates.end(), [](const candidate& x, const candidate& y) {
+                return x.len != y.len ? x.len < y.len : x.value < y.value;
+            });
+            std::vector<candidate> merged;
+            for (const candidate& c : candidates) {
+                if (!merged.empty() && merged.back().len == c.len && merged.back().value == c.value) merged.back().gain += c.gain;
+                else merged.push_back(c);
+            }
+            std::sort(merged.begin(), merged.end(), [](const candidate& x, const candidate& y) {
+                if (x.gain != y.gain) return x.gain > y.gain;
+                return x.len != y.len ? x.len > y.len : x.value < y.value;
+            });
+            if (merged.size() > MAX_SYMBOLS) merged.resize(MAX_SYMBOLS);
+
+            std::vector<std::pair<u64, u8>> chosen;
+            chosen.reserve(merged.size());
+            for (const candidate& c : merged) chosen.emplace_back(c.value, c.len);
+            table = symbol_table(chosen);
+        }
+        return table;
+    }
+
+    usize symbol_table::size() const {
+        return symbols.size();
+    }
+
+    std::string_view symbol_table::symbol(const u8 code) const {
+        if (code >= symbols.size()) throw Exception("No symbol with code ", cast(code, u32), " in a table of ", symbols.size(), " symbols");
+        return {reinterpret_cast<const char*>(&symbols[code]), lengths[code]};
+    }
+
+    usize symbol_table::compress(const std::string_view s, u8* out) const {
+        u8* const begin = out;
+        for (usize pos = 0; pos < s.size();) {
+            const u16 match = longestMatch(symbols, lengths, short_codes, byte_codes, bucket_start, long_codes, s.data() + pos, s.size() - pos);
+            const u8 code = match & 0xFF;
+            *out++ = code;
+            if (code == ESCAPE) *out++ = cast(s[pos], u8);
+            pos += match >> 8;
+        }
+        return out - begin;
+    }
+
+    usize symbol_table::decompressed_len(const u8* codes, const usize n) const {
+        usize ret = 0;
+        for (usize i = 0; i < n; i++) {
+            if (codes[i] == ESCAPE) {
+                i++;
+                ret++;
+            } else {
+                ret += lengths[codes[i]];
+            }
+        }
+        return ret;
+    }
+
+    usize symbol_table::decompress(const u8* codes, const usize n, char* out) const {
+        char* const begin = out;
+        for (usize i = 0; i < n; i++) {
+            if (codes[i] == ESCAPE) {
+                *out++ = cast(codes[++i], char);
+            } else {
+                std::memcpy(out, &symbols[codes[i]], lengths[codes[i]]);
+                out += lengths[codes[i]];
+            }
+        }
+        return out - begin;
+    }
+
+    str symbol_table::decompress(const u8* codes, const usize n) const {
+        str ret;
+        ret.resize_and_overwrite(decompressed_len(codes, n), [&](char* buffer, usize) {
+            return decompress(codes, n, buffer);
+        });
+        return ret;
+    }
+
+    i64 symbol_table::compare(const u8* codes, const usize n, const std::string_view s) const {
+        usize pos = 0;
+        for (usize i = 0; i < n; i++) {
+            char literal;
+            const char* piece;
+            usize len;
+            if (codes[i] == ESCAPE) {
+                literal = cast(codes[++i], char);
+                piece = &literal;
+                len = 1;
+            } else {
+                piece = reinterpret_cast<const char*>(&symbols[codes[i]]);
+                len = lengths[codes[i]];
+            }
+            const usize common = std::min(len, s.size() - pos);
+            if (const int c = std::memcmp(piece, s.data() + pos, common); c != 0) return c;
+            if (common < len) return 1;
+            pos += len;
+        }
+        return pos == s.size() ? 0 : -1;
+    }
+
+    bool symbol_table::startswith(const u8* codes, const usize n, const std::string_view prefix) const {
+        usize pos = 0;
+        for (usize i = 0; i < n && pos < prefix.size(); i++) {
+            char literal;
+            const char* piece;
+            usize len;
+            if (codes[i] == ESCAPE) {
+                literal = cast(codes[++i], char);
+                piece = &literal;
+                len = 1;
+            } else {
+                piece = reinterpret_cast<const char*>(&symbols[codes[i]]);
+                len = lengths[codes[i]];
+            }
+            const usize common = std::min(len, prefix.size() - pos);
+            if (std::memcmp(piece, prefix.data() + pos, common) != 0) return false;
+            pos += common;
+        }
+        return pos == prefix.size();
+    }
+
+    usize symbol_table::memory_usage() const {
+        return symbols.capacity()*sizeof(u64) + lengths.capacity() + short_codes.capacity()*sizeof(u16) + byte_codes.capacity()*sizeof(u16) +
+               bucket_start.capacity()*sizeof(u32) + long_codes.capacity();
+    }
+
+
+    compressed_strs::compressed_strs(symbol_table table) : table(std::move(table)) {}
+
+    const u8* compressed_strs::entry(const usize i) const {
+        if (i >= size()) throw Exception("Cannot access compressed string ", i, " of ", size());
+        return codes.data() + offsets[i];
+    }
+
+    usize compressed_strs::entryLen(const usize i) const {
+        return offsets[i+1] - offsets[i];
+    }
+
+    const symbol_table& compressed_strs::symbols() const {
+        return table;
+    }
+
+    usize compressed_strs::size() const {
+        return offsets.size() - 1;
+    }
+
+    bool compressed_strs::empty() const {
+        return size() == 0;
+    }
+
+    void compressed_strs::reserve(const usize strings, const usize bytes) {
+        offsets.reserve(strings + 1);
+        codes.reserve(bytes);
+    }
+
+    void compressed_strs::push_back(const std::string_view s) {
+        const usize start = codes.size();
+        codes.resize(start + symbol_table::max_compressed_len(s.size()));
+        codes.resize(start + table.compress(s, codes.data() + start));
+        offsets.push_back(codes.size());
+    }
+
+    str compressed_strs::get(const usize i) const {
+        return table.decompress(entry(i), entryLen(i));
+    }
+
+    str compressed_strs::operator[](const usize i) const {
+        return get(i);
+    }
+
+    std::string_view compressed_strs::get(const usize i, str& scratch) const {
+        const u8* e = entry(i);
+        scratch.resize_and_overwrite(table.decompressed_len(e, entryLen(i)), [&](char* buffer, usize) {
+            return table.decompress(e, entryLen(i), buffer);
+        });
+        return scratch;
+    }
+
+    usize compressed_strs::len(const usize i) const {
+        return table.decompressed_len(entry(i), entryLen(i));
+    }
+
+    i64 compressed_strs::compare(const usize i, const std::string_view s) const {
+        return table.compare(entry(i), entryLen(i), s);
+    }
+
+    bool compressed_strs::equals(const usize i, const std::string_view s) const {
+        return compare(i, s) == 0;
+    }
+
+    bool compressed_strs::startswith(const usize i, const std::string_view prefix) const {
+        return table.startswith(entry(i), entryLen(i), prefix);
+    }
+
+    usize compressed_strs::find(const std::string_view s, const usize begin) const {
+        //compression is deterministic, so two strings are equal exactly when their codes are
+        std::vector<u8> needle(symbol_table::max_compressed_len(s.size()));
+        needle.resize(table.compress(s, needle.data()));
+        for (usize i = begin; i < size(); i++) {
+            if (entryLen(i) == needle.size() && std::memcmp(codes.data() + offsets[i], needle.data(), needle.size()) == 0) return i;
+        }
+        return str::npos;
+    }
+
+    usize compressed_strs::compressed_bytes() const {
+        return codes.size();
+    }
+
+    usize compressed_strs::memory_usage() const {
+        return codes.capacity() + offsets.capacity()*sizeof(u64) + table.memory_usage();
+    }
+
+    void compressed_strs::clear() {
+        codes.clear();
+        offsets.assign(1, 0);
+    }
+}
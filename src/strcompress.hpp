@@ -0,0 +1,147 @@
+#ifndef STRCOMPRESS_HPP
+#define STRCOMPRESS_HPP
+
+#include <string_view>
+#include <vector>
+#include "misc.hpp"
+#include "str.hpp"
+
+#define AUSTINUTILS __declspec(dllexport)
+
+/*
+ * compression for large collections of short strings (urls, paths, user agents...), in the style of FSST
+ * a static table of up to 255 symbols of 1-8 bytes is trained on a sample, every symbol is then replaced by a one byte code
+ * bytes no symbol covers are written as an escape code followed by the byte itself
+ * every string is compressed on its own so any entry can be decompressed without touching the others
+ */
+
+namespace AustinUtils {
+
+    class AUSTINUTILS symbol_table {
+        //symbols are packed little endian into a u64, the unused high bytes are zero
+        std::vector<u64> symbols;
+        std::vector<u8> lengths;
+        //(length << 8) | code of the best symbol of at most 2 bytes for every 2 byte prefix, and for every single byte
+        std::vector<u16> short_codes;
+        std::vector<u16> byte_codes;
+        //the codes of symbols of 3+ bytes, grouped by their first 2 bytes, longest first
+        std::vector<u32> bucket_start;
+        std::vector<u8> long_codes;
+
+        explicit symbol_table(const std::vector<std::pair<u64, u8>>& chosen);
+
+    public:
+
+        static constexpr u8 ESCAPE = 255;
+        static constexpr usize MAX_SYMBOLS = 255;
+        static constexpr usize MAX_SYMBOL_LENGTH = 8;
+
+        //a table with no symbols, every byte is escaped
+        symbol_table();
+
+        //trains a table on the sample, only the first 32KB or so are used, spread evenly over the sample
+        NODISCARD static symbol_table train(const std::vector<std::string_view>& sample);
+
+        //trains a table on any iterable of strings convertible to std::string_view
+        template<typename Iterable>
+        NODISCARD static symbol_table train(const Iterable& strings) {
+            std::vector<std::string_view> sample;
+            for (const auto& s : strings) sample.emplace_back(s);
+            return train(sample);
+        }
+
+        NODISCARD usize size() const;
+
+        //returns the symbol a code stands for
+        NODISCARD std::string_view symbol(u8 code) const;
+
+        //returns the most bytes compress can write for n input bytes
+        NODISCARD static constexpr usize max_compressed_len(const usize n) {
+            return n*2;
+        }
+
+        //compresses s into out, which must have room for max_compressed_len(s.size()) bytes, returns the bytes written
+        usize compress(std::string_view s, u8* out) const;
+
+        //returns the length codes decompress to
+        NODISCARD usize decompressed_len(const u8* codes, usize n) const;
+
+        //decompresses n codes into out, which must have room for decompressed_len(codes, n) chars, returns the chars written
+        usize decompress(const u8* codes, usize n, char* out) const;
+
+        NODISCARD str decompress(const u8* codes, usize n) const;
+
+        //compares the decompressed codes to s like str::compare, stops at the first difference without decompressing the rest
+        NODISCARD i64 compare(const u8* codes, usize n, std::string_view s) const;
+
+        //returns true if the codes decompress to a string starting with prefix, stops as soon as it is decided
+        NODISCARD bool startswith(const u8* codes, usize n, std::string_view prefix) const;
+
+        //the bytes the lookup tables take up
+        NODISCARD usize memory_usage() const;
+    };
+
+    //a list of strings compressed with one shared symbol_table, stored back to back in one buffer
+    class AUSTINUTILS compressed_strs {
+        symbol_table table;
+        std::vector<u8> codes;
+        std::vector<u64> offsets = {0};
+
+        NODISCARD const u8* entry(usize i) const;
+
+        NODISCARD usize entryLen(usize i) const;
+
+    public:
+
+        explicit compressed_strs(symbol_table table = symbol_table());
+
+        //trains a table on strings and compresses all of them
+        template<typename Iterable>
+        NODISCARD static compressed_strs build(const Iterable& strings) {
+            compressed_strs ret(symbol_table::train(strings));
+            for (const auto& s : strings) ret.push_back(s);
+            return ret;
+        }
+
+        NODISCARD const symbol_table& symbols() const;
+
+        NODISCARD usize size() const;
+
+        NODISCARD bool empty() const;
+
+        void reserve(usize strings, usize bytes);
+
+        void push_back(std::string_view s);
+
+        //decompresses entry i
+        NODISCARD str get(usize i) const;
+
+        NODISCARD str operator [](usize i) const;
+
+        //decompresses entry i into scratch, reusing its buffer, and returns a view of it
+        std::string_view get(usize i, str& scratch) const;
+
+        //returns the decompressed length of entry i
+        NODISCARD usize len(usize i) const;
+
+        //compares entry i to s like str::compare without decompressing it
+        NODISCARD i64 compare(usize i, std::string_view s) const;
+
+        NODISCARD bool equals(usize i, std::string_view s) const;
+
+        NODISCARD bool startswith(usize i, std::string_view prefix) const;
+
+        //returns the index of the first entry equal to s, or str::npos, s is compressed once and matched against the compressed entries
+        NODISCARD usize find(std::string_view s, usize begin = 0) const;
+
+        //the compressed size of every entry, without the offsets or the table
+        NODISCARD usize compressed_bytes() const;
+
+        //everything the container holds on the heap, including the offsets and the table
+        NODISCARD usize memory_usage() const;
+
+        void clear();
+    };
+}
+
+#endif
@@ -0,0 +1,189 @@
+#include "strstats.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <vector>
+
+#include "str.hpp"
+
+
+namespace AustinUtils {
+
+    str_alloc_stats& str_alloc_stats::operator+=(const str_alloc_stats &other) {
+        allocations += other.allocations;
+        bytes_allocated += other.bytes_allocated;
+        padding_bytes += other.padding_bytes;
+        reallocations += other.reallocations;
+        deep_copies += other.deep_copies;
+        moves += other.moves;
+        c_str_copies += other.c_str_copies;
+        for (usize i = 0; i < STR_CAPACITY_BUCKETS; i++) capacity_histogram[i] += other.capacity_histogram[i];
+        return *this;
+    }
+
+    str_alloc_stats str_alloc_stats::operator-(const str_alloc_stats &other) const {
+        str_alloc_stats ret = *this;
+        ret.allocations -= other.allocations;
+        ret.bytes_allocated -= other.bytes_allocated;
+        ret.padding_bytes -= other.padding_bytes;
+        ret.reallocations -= other.reallocations;
+        ret.deep_copies -= other.deep_copies;
+        ret.moves -= other.moves;
+        ret.c_str_copies -= other.c_str_copies;
+        for (usize i = 0; i < STR_CAPACITY_BUCKETS; i++) ret.capacity_histogram[i] -= other.capacity_histogram[i];
+        return ret;
+    }
+
+    str str_alloc_stats::toStr() const {
+        str ret;
+        ret += "allocations: ";
+        ret += allocations;
+        ret += ", bytes: ";
+        ret += bytes_allocated;
+        ret += ", padding: ";
+        ret += padding_bytes;
+        ret += ", reallocations: ";
+        ret += reallocations;
+        ret += ", deep copies: ";
+        ret += deep_copies;
+        ret += ", moves: ";
+        ret += moves;
+        ret += ", c_str copies: ";
+        ret += c_str_copies;
+        ret += ", capacities: {";
+        bool first = true;
+        for (usize i = 0; i < STR_CAPACITY_BUCKETS; i++) {
+            if (capacity_histogram[i] == 0) continue;
+            if (!first) ret += ", ";
+            first = false;
+            ret += cast(1, u64) << i;
+            ret += "+: ";
+            ret += capacity_histogram[i];
+        }
+        ret += "}";
+        return ret;
+    }
+
+#ifdef AUSTINUTILS_STR_TELEMETRY
+
+    //only the owning thread writes its counters, so a relaxed load and store is enough and needs no locked instruction
+    struct str_counters {
+        std::atomic<u64> allocations{0};
+        std::atomic<u64> bytes_allocated{0};
+        std::atomic<u64> padding_bytes{0};
+        std::atomic<u64> reallocations{0};
+        std::atomic<u64> deep_copies{0};
+        std::atomic<u64> moves{0};
+        std::atomic<u64> c_str_copies{0};
+        std::atomic<u64> capacity_histogram[STR_CAPACITY_BUCKETS] = {};
+
+        str_counters();
+
+        ~str_counters();
+
+        static void bump(std::atomic<u64>& counter, const u64 n) {
+            counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        NODISCARD str_alloc_stats load() const {
+            str_alloc_stats ret;
+            ret.allocations = allocations.load(std::memory_order_relaxed);
+            ret.bytes_allocated = bytes_allocated.load(std::memory_order_relaxed);
+            ret.padding_bytes = padding_bytes.load(std::memory_order_relaxed);
+            ret.reallocations = reallocations.load(std::memory_order_relaxed);
+            ret.deep_copies = deep_copies.load(std::memory_order_relaxed);
+            ret.moves = moves.load(std::memory_order_relaxed);
+            ret.c_str_copies = c_str_copies.load(std::memory_order_relaxed);
+            for (usize i = 0; i < STR_CAPACITY_BUCKETS; i++) {
+                ret.capacity_histogram[i] = capacity_histogram[i].load(std::memory_order_relaxed);
+            }
+            return ret;
+        }
+    };
+
+    struct str_counter_registry {
+        std::mutex lock;
+        std::vector<const str_counters*> live;
+        //the counters of threads that have exited
+        str_alloc_stats retired;
+    };
+
+    static str_counter_registry& registry() {
+        static str_counter_registry r;
+        return r;
+    }
+
+    str_counters::str_counters() {
+        str_counter_registry& r = registry();
+        std::lock_guard guard(r.lock);
+        r.live.push_back(this);
+    }
+
+    str_counters::~str_counters() {
+        str_counter_registry& r = registry();
+        std::lock_guard guard(r.lock);
+        r.retired += load();
+        r.live.erase(std::find(r.live.begin(), r.live.end(), this));
+    }
+
+    static thread_local str_counters counters;
+
+    void str_record(const STR_EVENT event, const usize capacity, const usize used) {
+        switch (event) {
+            case STR_DEEP_COPY:
+                str_counters::bump(counters.deep_copies, 1);
+                return;
+            case STR_MOVE:
+                str_counters::bump(counters.moves, 1);
+                return;
+            case STR_REALLOCATION:
+                str_counters::bump(counters.reallocations, 1);
+                break;
+            case STR_C_STR_COPY:
+                str_counters::bump(counters.c_str_copies, 1);
+                break;
+            case STR_ALLOCATION:
+                break;
+        }
+
+        str_counters::bump(counters.allocations, 1);
+        str_counters::bump(counters.bytes_allocated, capacity);
+        if (capacity > used) str_counters::bump(counters.padding_bytes, capacity - used);
+        const usize bucket = std::min<usize>(std::bit_width(std::max<usize>(capacity, 1)) - 1, STR_CAPACITY_BUCKETS - 1);
+        str_counters::bump(counters.capacity_histogram[bucket], 1);
+    }
+
+    str_alloc_stats str_stats_thread() {
+        return counters.load();
+    }
+
+    str_alloc_stats str_stats_total() {
+        str_counter_registry& r = registry();
+        std::lock_guard guard(r.lock);
+        str_alloc_stats ret = r.retired;
+        for (const str_counters* c : r.live) ret += c->load();
+        return ret;
+    }
+
+    bool str_stats_enabled() {
+        return true;
+    }
+
+#else
+
+    str_alloc_stats str_stats_thread() {
+        return {};
+    }
+
+    str_alloc_stats str_stats_total() {
+        return {};
+    }
+
+    bool str_stats_enabled() {
+        return false;
+    }
+
+#endif
+}
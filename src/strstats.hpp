@@ -0,0 +1,63 @@
+#ifndef STRSTATS_HPP
+#define STRSTATS_HPP
+
+#include "misc.hpp"
+
+#define AUSTINUTILS __declspec(dllexport)
+
+/*
+ * allocation telemetry for str, compiled in only when AUSTINUTILS_STR_TELEMETRY is defined for the library build
+ * without it every hook is an empty inline function and the snapshots are all zero
+ */
+
+namespace AustinUtils {
+
+    class str;
+
+    //capacity histogram bucket i counts allocations with a capacity in [2^i, 2^(i+1))
+    constexpr usize STR_CAPACITY_BUCKETS = 48;
+
+    enum STR_EVENT {
+        STR_ALLOCATION,//a new buffer for a str
+        STR_REALLOCATION,//a new buffer from resize, the old one is copied and freed
+        STR_DEEP_COPY,//a copy constructor or copy assignment
+        STR_MOVE,//a move constructor or move assignment
+        STR_C_STR_COPY//a buffer handed out by c_str()
+    };
+
+    struct AUSTINUTILS str_alloc_stats {
+        u64 allocations = 0;//every heap allocation, including reallocations and c_str copies
+        u64 bytes_allocated = 0;
+        u64 padding_bytes = 0;//bytes allocated past the chars and null terminator the str needed at the time
+        u64 reallocations = 0;
+        u64 deep_copies = 0;
+        u64 moves = 0;
+        u64 c_str_copies = 0;
+        u64 capacity_histogram[STR_CAPACITY_BUCKETS] = {};
+
+        str_alloc_stats& operator +=(const str_alloc_stats& other);
+
+        //the difference between two snapshots, for measuring a section of code
+        NODISCARD str_alloc_stats operator -(const str_alloc_stats& other) const;
+
+        NODISCARD str toStr() const;
+    };
+
+    //returns the counters of the calling thread
+    NODISCARD extern AUSTINUTILS str_alloc_stats str_stats_thread();
+
+    //returns the counters summed over every thread, including threads that have exited
+    NODISCARD extern AUSTINUTILS str_alloc_stats str_stats_total();
+
+    //true if the library was built with AUSTINUTILS_STR_TELEMETRY
+    NODISCARD extern AUSTINUTILS bool str_stats_enabled();
+
+#ifdef AUSTINUTILS_STR_TELEMETRY
+    //records an event, capacity and used are the bytes allocated and the bytes the str needed
+    extern AUSTINUTILS void str_record(STR_EVENT event, usize capacity = 0, usize used = 0);
+#else
+    inline void str_record(STR_EVENT, usize = 0, usize = 0) {}
+#endif
+}
+
+#endif
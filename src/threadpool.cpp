@@ -0,0 +1,105 @@
+#include "threadpool.hpp"
+
+#include <atomic>
+#include <exception>
+#include <memory>
+
+
+namespace AustinUtils {
+
+    threadpool::threadpool(usize threads) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        workers.reserve(threads);
+        for (usize i = 0; i < threads; i++) {
+            workers.emplace_back(&threadpool::work, this);
+        }
+    }
+
+    threadpool::~threadpool() {
+        {
+            std::lock_guard guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& t : workers) t.join();
+    }
+
+    usize threadpool::size() const {
+        return workers.size();
+    }
+
+    void threadpool::work() {
+        loop {
+            std::function<void()> task;
+            {
+                std::unique_lock guard(lock);
+                wake.wait(guard, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty()) return;
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    void threadpool::submit(std::function<void()> task) {
+        {
+            std::lock_guard guard(lock);
+            tasks.push_back(std::move(task));
+        }
+        wake.notify_one();
+    }
+
+    void threadpool::parallel_for(const usize n, const std::function<void(usize)>& fn) {
+        if (n == 0) return;
+        if (n == 1 || workers.empty()) {
+            for (usize i = 0; i < n; i++) fn(i);
+            return;
+        }
+
+        //helpers may start after the caller already finished every index, so the state they touch is shared
+        struct state {
+            std::atomic<usize> next{0};
+            std::atomic<usize> done{0};
+            std::mutex lock;
+            std::condition_variable finished;
+            std::exception_ptr error;
+            usize n;
+            const std::function<void(usize)>* fn;
+        };
+        const auto shared = std::make_shared<state>();
+        shared->n = n;
+        shared->fn = &fn;
+
+        const auto run = [](state& s) {
+            usize i;
+            while ((i = s.next.fetch_add(1, std::memory_order_relaxed)) < s.n) {
+                try {
+                    (*s.fn)(i);
+                } catch (...) {
+                    std::lock_guard guard(s.lock);
+                    if (!s.error) s.error = std::current_exception();
+                }
+                if (s.done.fetch_add(1, std::memory_order_acq_rel) + 1 == s.n) {
+                    std::lock_guard guard(s.lock);
+                    s.finished.notify_all();
+                }
+            }
+        };
+
+        const usize helpers = std::min(workers.size(), n-1);
+        for (usize h = 0; h < helpers; h++) {
+            submit([shared, run] { run(*shared); });
+        }
+        run(*shared);
+
+        std::unique_lock guard(shared->lock);
+        shared->finished.wait(guard, [&] { return shared->done.load(std::memory_order_acquire) == n; });
+        if (shared->error) std::rethrow_exception(shared->error);
+    }
+
+    threadpool& threadpool::global() {
+        static threadpool pool;
+        return pool;
+    }
+}
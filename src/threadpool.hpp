@@ -0,0 +1,55 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "misc.hpp"
+
+#define AUSTINUTILS __declspec(dllexport)
+
+namespace AustinUtils {
+
+    //a fixed set of worker threads pulling tasks off a shared queue
+    class AUSTINUTILS threadpool {
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> tasks;
+        std::mutex lock;
+        std::condition_variable wake;
+        bool stopping = false;
+
+        void work();
+
+    public:
+
+        //creates a pool with the given number of workers, 0 means one per hardware thread
+        explicit threadpool(usize threads = 0);
+
+        threadpool(const threadpool&) = delete;
+
+        threadpool& operator =(const threadpool&) = delete;
+
+        //finishes the queued tasks and joins the workers
+        ~threadpool();
+
+        NODISCARD usize size() const;
+
+        //queues a task to run on one of the workers
+        void submit(std::function<void()> task);
+
+        /*
+         * runs fn(i) for every i in [0, n) on the workers and the calling thread, returning once every call is done
+         * the calling thread always takes part, so this can be nested inside a task without deadlocking
+         * the first exception thrown by fn is rethrown here
+         */
+        void parallel_for(usize n, const std::function<void(usize)>& fn);
+
+        //the pool shared by the library's parallel routines
+        static threadpool& global();
+    };
+}
+
+#endif
@@ -0,0 +1,221 @@
+#include "trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "Error.hpp"
+#include "logformat.hpp"
+#include "logging.hpp"
+#include "logsink.hpp"
+
+
+namespace AustinUtils {
+
+    struct trace_event {
+        const char* name;
+        const char* category;
+        u64 begin;
+        u64 end;
+    };
+
+    //one thread's spans, the thread is the only producer and the trace's background thread the only consumer
+    struct trace_ring {
+        std::unique_ptr<trace_event[]> events;
+        usize capacity;
+        u64 thread;
+        alignas(64) std::atomic<u64> head = 0;
+        alignas(64) std::atomic<u64> tail = 0;
+        std::atomic<bool> retired = false;
+
+        trace_ring(const usize capacity, const u64 thread) : events(std::make_unique<trace_event[]>(capacity)), capacity(capacity), thread(thread) {}
+    };
+
+    struct trace_state {
+        std::atomic<bool> recording = false;
+        std::atomic<u64> dropped = 0;
+
+        std::mutex lock;
+        std::condition_variable wake;
+        bool stopping = false;
+        std::vector<std::shared_ptr<trace_ring>> rings;
+        std::shared_ptr<log_sink> sink;
+        trace_options options;
+        std::thread writer;
+        bool first = true;
+        std::string out;
+    };
+
+    static trace_state& state() {
+        static trace_state s;
+        return s;
+    }
+
+    //the calling thread's ring, retired when the thread exits so the writer can let go of it after draining it
+    struct trace_local {
+        std::shared_ptr<trace_ring> ring;
+
+        ~trace_local() {
+            if (ring != null) ring->retired.store(true, std::memory_order_release);
+        }
+    };
+
+    static thread_local trace_local local;
+
+    static trace_ring* localRing() {
+        if (local.ring == null) {
+            trace_state& s = state();
+            std::lock_guard guard(s.lock);
+            local.ring = std::make_shared<trace_ring>(std::max<usize>(s.options.spans_per_thread, 1), log_thread_id());
+            s.rings.push_back(local.ring);
+        }
+        return local.ring.get();
+    }
+
+    bool trace_active() {
+        return state().recording.load(std::memory_order_relaxed);
+    }
+
+    u64 trace_dropped() {
+        return state().dropped.load(std::memory_order_relaxed);
+    }
+
+    u64 trace_now() {
+        return cast(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(), u64);
+    }
+
+    void trace_record(const char* name, const char* category, const u64 begin, const u64 end) {
+        trace_ring* r = localRing();
+        const u64 head = r->head.load(std::memory_order_relaxed);
+        if (head - r->tail.load(std::memory_order_acquire) >= r->capacity) {
+            state().dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        r->events[head % r->capacity] = {name, category, begin, end};
+        r->head.store(head + 1, std::memory_order_release);
+    }
+
+    //microseconds with three decimals, the unit the trace event format uses
+    static void appendMicros(std::string& out, const u64 ns) {
+        log_append(out, ns / 1000);
+        out.push_back('.');
+        const u64 rest = ns % 1000;
+        out.push_back(cast('0' + rest / 100, char));
+        out.push_back(cast('0' + rest / 10 % 10, char));
+        out.push_back(cast('0' + rest % 10, char));
+    }
+
+    //turns every ring's spans into complete ("ph":"X") events in s.out, lets go of retired rings once they are empty, lock must be held
+    static void drain(trace_state& s) {
+#ifdef _WIN32
+        const u64 pid = cast(_getpid(), u64);
+#else
+        const u64 pid = cast(getpid(), u64);
+#endif
+        for (usize i = 0; i < s.rings.size();) {
+            trace_ring& r = *s.rings[i];
+            //read retired first, anything recorded before the thread exited is then below head
+            const bool retired = r.retired.load(std::memory_order_acquire);
+            const u64 head = r.head.load(std::memory_order_acquire);
+            for (u64 t = r.tail.load(std::memory_order_relaxed); t < head; t++) {
+                const trace_event& e = r.events[t % r.capacity];
+                s.out.append(s.first ? "\n{\"name\":\"" : ",\n{\"name\":\"");
+                s.first = false;
+                log_append_escaped(s.out, LOG_ENCODING_JSON, e.name);
+                s.out.append("\",\"cat\":\"");
+                log_append_escaped(s.out, LOG_ENCODING_JSON, e.category);
+                s.out.append("\",\"ph\":\"X\",\"ts\":");
+                appendMicros(s.out, e.begin);
+                s.out.append(",\"dur\":");
+                appendMicros(s.out, e.end - std::min(e.begin, e.end));
+                s.out.append(",\"pid\":");
+                log_append(s.out, pid);
+                s.out.append(",\"tid\":");
+                log_append(s.out, r.thread);
+                s.out.push_back('}');
+            }
+            r.tail.store(head, std::memory_order_release);
+
+            if (retired) {
+                s.rings[i] = std::move(s.rings.back());
+                s.rings.pop_back();
+            } else {
+                i++;
+            }
+        }
+    }
+
+    //writes what drain collected, lock must be held
+    static void output(trace_state& s) {
+        if (s.out.empty()) return;
+        s.sink->write(LOG_INFO, s.out);
+        s.sink->submit();
+        s.out.clear();
+    }
+
+    static void run() {
+        trace_state& s = state();
+        std::string text;
+        std::unique_lock guard(s.lock);
+        while (!s.stopping) {
+            s.wake.wait_for(guard, s.options.flush_interval, [&] { return s.stopping; });
+            drain(s);
+            if (s.out.empty()) continue;
+            //the sink is written without the lock, so a thread recording its first span never waits for the disk
+            std::swap(text, s.out);
+            guard.unlock();
+            s.sink->write(LOG_INFO, text);
+            s.sink->submit();
+            text.clear();
+            guard.lock();
+        }
+    }
+
+    void trace_start(std::shared_ptr<log_sink> sink, const trace_options options) {
+        if (sink == null) throw Exception("Cannot trace to a null sink");
+        trace_state& s = state();
+        {
+            std::lock_guard guard(s.lock);
+            if (s.writer.joinable()) throw Exception("A trace is already running, stop it before starting another");
+            s.sink = std::move(sink);
+            s.options = options;
+            s.stopping = false;
+            s.first = true;
+            s.dropped.store(0);
+            //spans that ended after the last trace stopped belong to neither
+            for (const std::shared_ptr<trace_ring>& r : s.rings) r->tail.store(r->head.load(std::memory_order_acquire), std::memory_order_release);
+            s.out = "[";
+            output(s);
+            s.writer = std::thread(run);
+        }
+        s.recording.store(true, std::memory_order_release);
+    }
+
+    void trace_stop() {
+        trace_state& s = state();
+        s.recording.store(false, std::memory_order_release);
+        {
+            std::lock_guard guard(s.lock);
+            if (!s.writer.joinable()) return;
+            s.stopping = true;
+        }
+        s.wake.notify_one();
+        s.writer.join();
+
+        std::lock_guard guard(s.lock);
+        drain(s);
+        s.out.append("\n]\n");
+        output(s);
+        s.sink->flush();
+        s.sink = null;
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <chrono>
+#include <memory>
+#include "misc.hpp"
+
+#define AUSTINUTILS __declspec(dllexport)
+
+/*
+ * scoped spans recording where time goes, written as Chrome trace event JSON that chrome://tracing and the Perfetto UI open
+ * a span is recorded when it ends, into a lock-free ring of the thread it ran on, a background thread drains every ring into a sink
+ * spans only cost a relaxed load while no trace is running, and nothing at all unless AUSTINUTILS_TRACING is defined as 1 when building
+ */
+
+/*
+ * 1 compiles the AUSTINUTILS_TRACE_SPAN macros in, including the ones inside the library (matrix::operator*, str::split...),
+ * 0 (the default) removes them entirely, trace_span itself can always be used directly
+ */
+#ifndef AUSTINUTILS_TRACING
+#define AUSTINUTILS_TRACING 0
+#endif
+
+#define AUSTINUTILS_TRACE_JOIN2(a, b) a##b
+#define AUSTINUTILS_TRACE_JOIN(a, b) AUSTINUTILS_TRACE_JOIN2(a, b)
+
+#if AUSTINUTILS_TRACING
+//traces the rest of the enclosing scope, takes the same arguments as trace_span
+#define AUSTINUTILS_TRACE_SPAN(...) const ::AustinUtils::trace_span AUSTINUTILS_TRACE_JOIN(austinutils_trace_span_, __LINE__)(__VA_ARGS__)
+#else
+#define AUSTINUTILS_TRACE_SPAN(...) ((void)0)
+#endif
+
+namespace AustinUtils {
+
+    class log_sink;
+
+    struct trace_options {
+        //every thread that records gets a ring of this many spans, spans that find it full are dropped and counted
+        usize spans_per_thread = 1 << 16;
+        //how often the background thread drains the rings
+        std::chrono::milliseconds flush_interval = std::chrono::milliseconds(100);
+    };
+
+    /*
+     * starts recording spans and writing them to sink as one JSON array, one span per line, throws if a trace is already running
+     * the array is closed by trace_stop(), a file cut short by a crash still opens in both viewers
+     */
+    extern AUSTINUTILS void trace_start(std::shared_ptr<log_sink> sink, trace_options options = trace_options());
+
+    //stops recording, writes everything recorded so far, closes the array and flushes the sink
+    extern AUSTINUTILS void trace_stop();
+
+    NODISCARD extern AUSTINUTILS bool trace_active();
+
+    //spans dropped because their thread's ring was full, since the trace started
+    NODISCARD extern AUSTINUTILS u64 trace_dropped();
+
+    //nanoseconds from a monotonic clock, what spans are timed with
+    NODISCARD extern AUSTINUTILS u64 trace_now();
+
+    //records a finished span of the calling thread, name and category must live until the trace is stopped, string literals do
+    extern AUSTINUTILS void trace_record(const char* name, const char* category, u64 begin, u64 end);
+
+    //records the time from its construction to its destruction, if a trace was running when it was constructed
+    class AUSTINUTILS trace_span {
+        const char* name;
+        const char* category;
+        u64 begin;
+
+    public:
+        explicit trace_span(const char* name, const char* category = "app") : name(name), category(category), begin(trace_active() ? trace_now() : 0) {}
+
+        trace_span(const trace_span&) = delete;
+
+        trace_span& operator =(const trace_span&) = delete;
+
+        ~trace_span() {
+            if (begin != 0) trace_record(name, category, begin, trace_now());
+        }
+    };
+}
+
+#endif
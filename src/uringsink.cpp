@@ -0,0 +1,351 @@
+#include "uringsink.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <thread>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#include "Error.hpp"
+#include "logging.hpp"
+
+
+namespace AustinUtils {
+
+    //writes all of data at offset, giving up on errors, there is nowhere left to report them
+    static void writeAt(const int fd, const char* data, usize n, u64 offset) {
+        while (n > 0) {
+#ifdef _WIN32
+            if (_lseeki64(fd, cast(offset, __int64), SEEK_SET) < 0) return;
+            const auto written = ::_write(fd, data, cast(n, unsigned));
+#else
+            const auto written = ::pwrite(fd, data, n, cast(offset, off_t));
+#endif
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return;
+            }
+            data += written;
+            n -= written;
+            offset += written;
+        }
+    }
+
+#ifdef __linux__
+    /*
+     * the parts of an io_uring this sink uses, mapped by hand instead of through liburing
+     * only ever touched with the sink's lock held, so there is one producer and one consumer on each side
+     */
+    struct uring_sink::ring {
+        int fd = -1;
+        bool fixed = false;
+
+        void* sq_map = MAP_FAILED;
+        usize sq_size = 0;
+        void* cq_map = MAP_FAILED;
+        usize cq_size = 0;
+        io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+        usize sqes_size = 0;
+
+        unsigned* sq_head;
+        unsigned* sq_tail;
+        unsigned sq_mask;
+        unsigned* sq_array;
+        unsigned* cq_head;
+        unsigned* cq_tail;
+        unsigned cq_mask;
+        io_uring_cqe* cqes;
+
+        //false if the kernel does not have io_uring or does not let this process use it
+        bool open(const u32 depth) {
+            io_uring_params params = {};
+            fd = cast(syscall(__NR_io_uring_setup, depth, &params), int);
+            if (fd < 0) return false;
+
+            sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            const bool single = params.features & IORING_FEAT_SINGLE_MMAP;
+            if (single) sq_size = cq_size = std::max(sq_size, cq_size);
+
+            sq_map = mmap(null, sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+            if (sq_map == MAP_FAILED) return false;
+            if (single) {
+                cq_map = sq_map;
+            } else {
+                cq_map = mmap(null, cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+                if (cq_map == MAP_FAILED) return false;
+            }
+            sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+            sqes = static_cast<io_uring_sqe*>(mmap(null, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+            if (sqes == MAP_FAILED) return false;
+
+            u8* sq = static_cast<u8*>(sq_map);
+            sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+            sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+            u8* cq = static_cast<u8*>(cq_map);
+            cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+            return true;
+        }
+
+        //registering the buffers saves the kernel mapping them on every write, it can fail on a low RLIMIT_MEMLOCK, plain writes still work
+        void registerBuffers(const std::vector<iovec>& buffers) {
+            fixed = syscall(__NR_io_uring_register, fd, IORING_REGISTER_BUFFERS, buffers.data(), cast(buffers.size(), unsigned)) == 0;
+        }
+
+        //queues and submits a write of n bytes of buffer index at offset, false if the ring did not take it
+        bool write(const int file, const char* data, const usize n, const u64 offset, const usize index) {
+            const unsigned tail = *sq_tail;
+            if (tail - std::atomic_ref(*sq_head).load(std::memory_order_acquire) > sq_mask) return false;
+            const unsigned slot = tail & sq_mask;
+            io_uring_sqe& sqe = sqes[slot];
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = fixed ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+            sqe.fd = file;
+            sqe.addr = reinterpret_cast<u64>(data);
+            sqe.len = cast(n, u32);
+            sqe.off = offset;
+            if (fixed) sqe.buf_index = cast(index, u16);
+            sqe.user_data = index;
+            sq_array[slot] = slot;
+            std::atomic_ref(*sq_tail).store(tail + 1, std::memory_order_release);
+            if (enter(1, 0)) return true;
+            //a failed io_uring_enter took nothing, the entry is taken back so the kernel never picks it up once the buffer is reused
+            std::atomic_ref(*sq_tail).store(tail, std::memory_order_release);
+            return false;
+        }
+
+        bool enter(const unsigned submit, const unsigned wait) const {
+            loop {
+                const long r = syscall(__NR_io_uring_enter, fd, submit, wait, wait != 0 ? IORING_ENTER_GETEVENTS : 0, null, 0);
+                if (r >= 0) return true;
+                if (errno != EINTR) return false;
+            }
+        }
+
+        //calls done(index, result) for every finished write
+        template<typename F>
+        void completions(F&& done) {
+            unsigned head = *cq_head;
+            const unsigned tail = std::atomic_ref(*cq_tail).load(std::memory_order_acquire);
+            for (; head != tail; head++) {
+                const io_uring_cqe& cqe = cqes[head & cq_mask];
+                done(cast(cqe.user_data, usize), cqe.res);
+            }
+            std::atomic_ref(*cq_head).store(head, std::memory_order_release);
+        }
+
+        ~ring() {
+            if (sqes != MAP_FAILED) munmap(sqes, sqes_size);
+            if (cq_map != MAP_FAILED && cq_map != sq_map) munmap(cq_map, cq_size);
+            if (sq_map != MAP_FAILED) munmap(sq_map, sq_size);
+            if (fd >= 0) ::close(fd);
+        }
+    };
+#else
+    struct uring_sink::ring {};
+#endif
+
+
+    uring_sink_options::uring_sink_options() : flush_on(LOG_ERROR) {}
+
+    uring_sink::uring_sink(std::string path, const uring_sink_options options) : path(std::move(path)), options(options) {
+        this->options.buffer_bytes = std::max<usize>(this->options.buffer_bytes, 1);
+        this->options.queue_depth = std::clamp<u32>(this->options.queue_depth, 1, 1024);
+
+        fd = ::open(this->path.c_str(), O_WRONLY | O_CREAT, 0644);
+        if (fd < 0) throw Exception("Could not open log file ", this->path, ": ", std::strerror(errno));
+        const auto end = ::lseek(fd, 0, SEEK_END);
+        offset = end < 0 ? 0 : cast(end, u64);
+
+        //one buffer fills while queue_depth are in flight
+        buffers.resize(this->options.queue_depth + 1);
+        for (buffer& b : buffers) b.data = std::make_unique<char[]>(this->options.buffer_bytes);
+
+#ifdef __linux__
+        if (this->options.use_uring) {
+            uring = std::make_unique<ring>();
+            if (uring->open(this->options.queue_depth)) {
+                std::vector<iovec> iovs;
+                for (const buffer& b : buffers) iovs.push_back({b.data.get(), this->options.buffer_bytes});
+                uring->registerBuffers(iovs);
+            } else {
+                uring = null;
+            }
+        }
+#endif
+    }
+
+    uring_sink::~uring_sink() {
+        flush();
+        uring = null;
+        if (fd >= 0) ::close(fd);
+    }
+
+    bool uring_sink::using_uring() const {
+        std::lock_guard guard(lock);
+        return uring != null;
+    }
+
+    const std::string& uring_sink::file() const {
+        return path;
+    }
+
+    void uring_sink::finished(const usize index, const int result) {
+        buffer& b = buffers[index];
+        //a short write is finished on the spot, a failed one is dropped
+        if (result >= 0 && cast(result, usize) < b.size) writeAt(fd, b.data.get() + result, b.size - result, b.offset + result);
+        b.in_flight = false;
+        b.size = 0;
+    }
+
+    void uring_sink::reap(const bool wait) {
+#ifdef __linux__
+        if (wait && !uring->enter(0, 1)) {
+            abandonRing();
+            return;
+        }
+        uring->completions([&](const usize index, const int result) { finished(index, result); });
+#else
+        (void)wait;
+#endif
+    }
+
+    void uring_sink::abandonRing() {
+#ifdef __linux__
+        //the kernel still owns the buffers of the writes it took, they finish and show up in the completion queue without io_uring_enter
+        loop {
+            uring->completions([&](const usize index, const int result) { finished(index, result); });
+            if (std::none_of(buffers.begin(), buffers.end(), [](const buffer& b) { return b.in_flight; })) break;
+            std::this_thread::yield();
+        }
+        uring = null;
+#endif
+    }
+
+    void uring_sink::writePending() {
+        if (pending.empty()) return;
+#ifdef _WIN32
+        for (const usize i : pending) writeAt(fd, buffers[i].data.get(), buffers[i].size, buffers[i].offset);
+#else
+        //the pending buffers follow each other in the file, so they go out in one call
+        std::vector<iovec> iovs;
+        iovs.reserve(pending.size());
+        for (const usize i : pending) iovs.push_back({buffers[i].data.get(), buffers[i].size});
+        u64 at = buffers[pending.front()].offset;
+        usize first = 0;
+        while (first < iovs.size()) {
+            const auto written = ::pwritev(fd, iovs.data() + first, cast(std::min<usize>(iovs.size() - first, IOV_MAX), int), cast(at, off_t));
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+            at += written;
+            //skip what was written, a buffer cut in the middle is resumed from there
+            usize left = written;
+            while (first < iovs.size() && left >= iovs[first].iov_len) left -= iovs[first++].iov_len;
+            if (first < iovs.size()) {
+                iovs[first].iov_base = static_cast<char*>(iovs[first].iov_base) + left;
+                iovs[first].iov_len -= left;
+            }
+        }
+#endif
+        for (const usize i : pending) {
+            buffers[i].in_flight = false;
+            buffers[i].size = 0;
+        }
+        pending.clear();
+    }
+
+    void uring_sink::drain() {
+        if (uring != null) {
+            while (std::any_of(buffers.begin(), buffers.end(), [](const buffer& b) { return b.in_flight; })) reap(true);
+        } else {
+            writePending();
+        }
+    }
+
+    usize uring_sink::freeBuffer() {
+        loop {
+            for (usize i = 0; i < buffers.size(); i++) {
+                if (!buffers[i].in_flight && i != active) return i;
+            }
+            if (uring != null) reap(true);
+            else writePending();
+        }
+    }
+
+    void uring_sink::submitActive() {
+        buffer& b = buffers[active];
+        if (b.size == 0) return;
+        b.offset = offset;
+        offset += b.size;
+        b.in_flight = true;
+        bool queued = false;
+#ifdef __linux__
+        if (uring != null) {
+            reap(false);
+            queued = uring->write(fd, b.data.get(), b.size, b.offset, active);
+            if (!queued) {
+                //the ring refused it, write it here rather than lose it, and stop using a ring that fails
+                writeAt(fd, b.data.get(), b.size, b.offset);
+                b.in_flight = false;
+                b.size = 0;
+                queued = true;
+                abandonRing();
+            }
+        }
+#endif
+        if (!queued) pending.push_back(active);
+        active = freeBuffer();
+    }
+
+    void uring_sink::write(const LOG_TYPE type, const std::string_view lines) {
+        const bool urgent = LogSeverity(type) >= LogSeverity(options.flush_on);
+        std::lock_guard guard(lock);
+        if (buffers[active].size + lines.size() > options.buffer_bytes) submitActive();
+        if (lines.size() > options.buffer_bytes) {
+            //too big for any buffer, it is written straight away behind what is in flight, pending buffers have to stay next to each other
+            writePending();
+            writeAt(fd, lines.data(), lines.size(), offset);
+            offset += lines.size();
+        } else {
+            buffer& b = buffers[active];
+            std::memcpy(b.data.get() + b.size, lines.data(), lines.size());
+            b.size += lines.size();
+        }
+        if (urgent) {
+            submitActive();
+            drain();
+        }
+    }
+
+    void uring_sink::flush() {
+        std::lock_guard guard(lock);
+        submitActive();
+        drain();
+    }
+
+    void uring_sink::submit() {
+        std::lock_guard guard(lock);
+        submitActive();
+        if (uring != null) reap(false);
+        else writePending();
+    }
+}
@@ -0,0 +1,110 @@
+#ifndef URINGSINK_HPP
+#define URINGSINK_HPP
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "misc.hpp"
+#include "logsink.hpp"
+
+#define AUSTINUTILS __declspec(dllexport)
+
+namespace AustinUtils {
+
+    enum LOG_TYPE : int;
+
+    struct uring_sink_options {
+        //lines are collected in buffers of this size, a full buffer is handed to the kernel while the next one fills
+        usize buffer_bytes = 1 << 20;
+        //how many buffers can be in flight at once, also the size of the submission queue
+        u32 queue_depth = 4;
+        //lines at least this severe are written out straight away
+        LOG_TYPE flush_on;
+        //false always uses the pwritev fallback
+        bool use_uring = true;
+
+        uring_sink_options();
+    };
+
+    /*
+     * appends lines to a file without the thread that logs waiting for the disk, linux only, through raw io_uring syscalls
+     * full buffers are submitted as writes at explicit offsets from a set of buffers registered with the kernel once,
+     * their completions are collected later, only flush() and running out of free buffers wait
+     * where io_uring is missing or not allowed the full buffers are written in batches with one pwritev each instead
+     * the file is assumed to be written by this sink only, it does not rotate, use file_sink for that
+     */
+    class AUSTINUTILS uring_sink : public log_sink {
+    public:
+        struct ring;
+
+    private:
+        struct buffer {
+            std::unique_ptr<char[]> data;
+            usize size = 0;
+            u64 offset = 0;
+            bool in_flight = false;
+        };
+
+        std::string path;
+        uring_sink_options options;
+        int fd = -1;
+        u64 offset = 0;
+        std::unique_ptr<ring> uring;
+
+        mutable std::mutex lock;
+        std::vector<buffer> buffers;
+        usize active = 0;
+        //the fallback's full buffers, in file order, waiting for one pwritev
+        std::vector<usize> pending;
+
+        //hands the active buffer over and makes another one active, lock must be held
+        void submitActive();
+
+        //collects finished writes, waiting for at least one if wait is set, lock must be held
+        void reap(bool wait);
+
+        //hands a buffer back once the kernel has written it, lock must be held
+        void finished(usize index, int result);
+
+        //the ring failed a call, waits out the writes the kernel already took and uses the pwritev fallback from then on, lock must be held
+        void abandonRing();
+
+        //writes the fallback's pending buffers with one pwritev, lock must be held
+        void writePending();
+
+        //waits until nothing is in flight, lock must be held
+        void drain();
+
+        //a buffer that is not in flight, waiting for one if needed, lock must be held
+        usize freeBuffer();
+
+    public:
+
+        //opens path for appending, creating it if needed, throws if it can not be opened
+        explicit uring_sink(std::string path, uring_sink_options options = uring_sink_options());
+
+        uring_sink(const uring_sink&) = delete;
+
+        uring_sink& operator =(const uring_sink&) = delete;
+
+        //writes out everything and closes the file
+        ~uring_sink() override;
+
+        void write(LOG_TYPE type, std::string_view lines) override;
+
+        //submits the active buffer and waits for every write in flight
+        void flush() override;
+
+        //submits the active buffer without waiting
+        void submit() override;
+
+        //true if writes go through io_uring, false if they use the pwritev fallback, which they switch to for good if the ring fails
+        NODISCARD bool using_uring() const;
+
+        NODISCARD const std::string& file() const;
+    };
+}
+
+#endif
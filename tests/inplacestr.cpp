@@ -0,0 +1,88 @@
+// checks that numbers appended to an inplace_str are either written whole or go through the overflow policy
+//
+// build from the repository root:
+//   g++ -std=c++20 -O2 -Isrc tests/inplacestr.cpp src/*.cpp -lbacktrace -ldl -pthread -o inplacestr_test
+// run:
+//   ./inplacestr_test, exits with 1 and says what failed if anything did
+
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <string_view>
+#include "AustinUtils.hpp"
+
+using namespace AustinUtils;
+
+static int failures = 0;
+
+#define CHECK(condition) do { if (!(condition)) { std::fprintf(stderr, "%s:%d: %s failed\n", __FILE__, __LINE__, #condition); failures++; } } while (0)
+
+//what inplace_str should write, formatted through the standard library
+static std::string fixed(const double x, const int precision = 6) {
+    const int n = std::snprintf(null, 0, "%.*f", precision, x);
+    std::string s(cast(n, usize), '\0');
+    std::snprintf(s.data(), s.size() + 1, "%.*f", precision, x);
+    return s;
+}
+
+template<usize N, INPLACE_OVERFLOW P>
+static bool throws(inplace_str<N, P>& s, const double x) {
+    try {
+        s.append(x);
+    } catch (const Error&) {
+        return true;
+    }
+    return false;
+}
+
+int main() {
+    //far past the 64 chars a scratch buffer used to hold, but written whole when there is room
+    for (const double x : {1e57, -3.5e120, 1e300, std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest()}) {
+        inplace_str<512> s;
+        s.append(x);
+        CHECK(std::string_view(s) == fixed(x));
+        inplace_str<512> t;
+        CHECK(t.try_append(x));
+        CHECK(std::string_view(t) == fixed(x));
+    }
+    inplace_str<512> decimals;
+    decimals.append(1.0 / 3, 200);
+    CHECK(std::string_view(decimals) == fixed(1.0 / 3, 200));
+
+    //only real infinities and nans are written as such
+    inplace_str<16> inf;
+    inf.append(std::numeric_limits<double>::infinity());
+    inf.append(' ');
+    inf.append(-std::numeric_limits<double>::infinity());
+    inf.append(' ');
+    inf.append(std::numeric_limits<double>::quiet_NaN());
+    CHECK(std::string_view(inf) == "inf -inf nan");
+
+    //a number that does not fit throws, and leaves the string as it was
+    inplace_str<32> thrown = "x=";
+    CHECK(throws(thrown, 1e57));
+    CHECK(std::string_view(thrown) == "x=");
+    thrown.append(2.5);
+    CHECK(std::string_view(thrown) == "x=2.500000");
+
+    //or keeps its leading digits
+    inplace_str<32, INPLACE_TRUNCATE> truncated = "x=";
+    truncated.append(1e57);
+    CHECK(std::string_view(truncated) == "x=" + fixed(1e57).substr(0, 30));
+    inplace_str<32, INPLACE_TRUNCATE> many = "x=";
+    many.append(0.5, 1000);
+    CHECK(std::string_view(many) == "x=" + fixed(0.5, 1000).substr(0, 30));
+
+    //try_append never keeps part of a number
+    inplace_str<32> tried = "x=";
+    CHECK(!tried.try_append(1e57));
+    CHECK(std::string_view(tried) == "x=");
+    CHECK(tried.try_append(-0.125));
+    CHECK(std::string_view(tried) == "x=-0.125000");
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+    std::printf("all inplace_str checks passed\n");
+}
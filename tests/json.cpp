@@ -0,0 +1,63 @@
+// checks that json_value reads numbers exactly and rejects ones that do not fit
+//
+// build from the repository root:
+//   g++ -std=c++20 -O2 -Isrc tests/json.cpp src/*.cpp -lbacktrace -ldl -pthread -o json_test
+// run:
+//   ./json_test, exits with 1 and says what failed if anything did
+
+#include <cstdio>
+#include <limits>
+#include <string>
+#include "AustinUtils.hpp"
+
+using namespace AustinUtils;
+
+static int failures = 0;
+
+#define CHECK(condition) do { if (!(condition)) { std::fprintf(stderr, "%s:%d: %s failed\n", __FILE__, __LINE__, #condition); failures++; } } while (0)
+
+template<typename F>
+static bool throws(F&& f) {
+    try {
+        (void)f();
+    } catch (const Error&) {
+        return true;
+    }
+    return false;
+}
+
+int main() {
+    const std::string document = R"({"g":0.1,"e":-3.5e2,"tiny":2.2250738585072014e-308,"third":0.333333333333333314829616256247390992939472198486328125,)"
+                                 R"("max":9223372036854775807,"over":9223372036854775808,"under":-9223372036854775809,"umax":18446744073709551615,)"
+                                 R"("uover":18446744073709551616,"neg":-1,"frac":1.5,"exp":1e3,"huge":1e400})";
+    json_index index{std::string_view(document)};
+    const json_value root = index.root();
+
+    //rounded once, to the same double the literal gives
+    CHECK(root["g"].get_double() == 0.1);
+    CHECK(root["e"].get_double() == -3.5e2);
+    CHECK(root["tiny"].get_double() == 2.2250738585072014e-308);
+    //longer than any fixed buffer the old parser used
+    CHECK(root["third"].get_double() == 1.0 / 3);
+    CHECK(throws([&] { return root["huge"].get_double(); }));
+
+    CHECK(root["max"].get_i64() == std::numeric_limits<i64>::max());
+    CHECK(root["umax"].get_u64() == std::numeric_limits<u64>::max());
+    CHECK(root["max"].get_u64() == 9223372036854775807ull);
+    CHECK(root["neg"].get_i64() == -1);
+
+    //out of range, negative or not whole, none of them are clamped or cut short
+    CHECK(throws([&] { return root["over"].get_i64(); }));
+    CHECK(throws([&] { return root["under"].get_i64(); }));
+    CHECK(throws([&] { return root["uover"].get_u64(); }));
+    CHECK(throws([&] { return root["neg"].get_u64(); }));
+    CHECK(throws([&] { return root["frac"].get_i64(); }));
+    CHECK(throws([&] { return root["exp"].get_u64(); }));
+    CHECK(root["exp"].get_double() == 1000);
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+    std::printf("all json checks passed\n");
+}
@@ -0,0 +1,57 @@
+// checks that kv fields come out as valid logfmt and JSON whatever their keys and values hold
+//
+// build from the repository root:
+//   g++ -std=c++20 -O2 -Isrc tests/logkv.cpp src/*.cpp -lbacktrace -ldl -pthread -o logkv_test
+// run:
+//   ./logkv_test, exits with 1 and says what failed if anything did
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include "AustinUtils.hpp"
+
+using namespace AustinUtils;
+
+static int failures = 0;
+
+#define CHECK(condition) do { if (!(condition)) { std::fprintf(stderr, "%s:%d: %s failed\n", __FILE__, __LINE__, #condition); failures++; } } while (0)
+
+//keeps the last line written to it
+class capture_sink : public log_sink {
+public:
+    std::string last;
+
+    void write(LOG_TYPE, const std::string_view lines) override {
+        last.assign(lines);
+    }
+
+    void flush() override {}
+};
+
+int main() {
+    const auto sink = std::make_shared<capture_sink>();
+    logger lg("kv");
+    lg.set_sink(sink);
+
+    lg.set_encoding(LOG_ENCODING_LOGFMT);
+    lg.info("done", kv("user", "jo smith"), kv("ms", 12.5));
+    CHECK(sink->last == "level=INFO logger=kv msg=\"done\" user=\"jo smith\" ms=12.5\n");
+    //logfmt has no quoted keys, so anything that would end the key early becomes '_'
+    lg.info("done", kv("k k", "a b"), kv("a=b", 1), kv("q\"\\", 2), kv("tab\t", 3), kv("", 4));
+    CHECK(sink->last == "level=INFO logger=kv msg=\"done\" k_k=\"a b\" a_b=1 q__=2 tab_=3 _=4\n");
+
+    //JSON escapes the key instead
+    lg.set_encoding(LOG_ENCODING_JSON);
+    lg.info("done", kv("k \"k\"", "a b"));
+    CHECK(sink->last == "{\"level\":\"INFO\",\"logger\":\"kv\",\"msg\":\"done\",\"k \\\"k\\\"\":\"a b\"}\n");
+
+    lg.set_encoding(LOG_ENCODING_TEXT);
+    lg.info("done", kv("k k", 1));
+    CHECK(sink->last == "[INFO][kv]: done k_k=1\n");
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+    std::printf("all kv checks passed\n");
+}
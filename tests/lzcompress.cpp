@@ -0,0 +1,96 @@
+// round trips through the lz codec and frames, and checks that damaged frames are rejected without touching the output
+//
+// build from the repository root:
+//   g++ -std=c++20 -O2 -Isrc tests/lzcompress.cpp src/*.cpp -lbacktrace -ldl -pthread -o lzcompress_test
+// run:
+//   ./lzcompress_test, exits with 1 and says what failed if anything did
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include "AustinUtils.hpp"
+
+using namespace AustinUtils;
+
+static int failures = 0;
+
+#define CHECK(condition) do { if (!(condition)) { std::fprintf(stderr, "%s:%d: %s failed\n", __FILE__, __LINE__, #condition); failures++; } } while (0)
+
+static std::string logText(const usize n, std::mt19937_64& random) {
+    std::string s;
+    while (s.size() < n) s += "[INFO][db]: query " + std::to_string(random() % 1000) + " took " + std::to_string(random() % 50) + " ms\n";
+    s.resize(n);
+    return s;
+}
+
+static void roundTrip(const std::string& s) {
+    std::string compressed(lz_max_compressed_len(s.size()), '\0');
+    const usize n = lz_compress(s.data(), s.size(), compressed.data());
+    std::string decompressed(s.size(), '\0');
+    CHECK(lz_decompress(compressed.data(), n, decompressed.data(), decompressed.size()) == s.size());
+    CHECK(decompressed == s);
+
+    std::string frame;
+    lz_frame_append(frame, s);
+    std::string out = "before";
+    CHECK(lz_frame_read(frame, out) == frame.size());
+    CHECK(out == "before" + s);
+    if (!frame.empty()) CHECK(lz_frame_read(std::string_view(frame).substr(0, frame.size() - 1), out) == 0);
+}
+
+//true if reading frame threw and left out as it was
+static bool rejected(const std::string& frame) {
+    std::string out = "before";
+    try {
+        (void)lz_frame_read(frame, out);
+    } catch (const Error&) {
+        return out == "before";
+    }
+    return false;
+}
+
+int main() {
+    std::mt19937_64 random(1);
+    for (const usize n : {0, 1, 4, 12, 13, 100, 255, 4096, 70000}) {
+        roundTrip(std::string(n, 'a'));
+        roundTrip(logText(n, random));
+        std::string noise(n, '\0');
+        for (char& c : noise) c = cast(random(), char);
+        roundTrip(noise);
+    }
+
+    const std::string text = logText(12000, random);
+    std::string frame;
+    lz_frame_append(frame, text);
+
+    //every flipped bit past the magic is caught by a checksum or the decoder, and the output is left alone
+    usize missed = 0;
+    for (usize i = 0; i < 20000; i++) {
+        std::string damaged = frame;
+        damaged[4 + random() % (damaged.size() - 4)] ^= cast(1 << random() % 8, char);
+        std::string out = "before";
+        try {
+            (void)lz_frame_read(damaged, out);
+            if (out != "before" + text) missed++;
+        } catch (const Error&) {
+            CHECK(out == "before");
+        }
+    }
+    CHECK(missed == 0);
+
+    //a bad token in the block makes the decoder throw halfway through
+    std::string bad_token = frame;
+    bad_token[LZ_FRAME_HEADER] = cast(0xFF, char);
+    CHECK(rejected(bad_token));
+
+    //a damaged block size is reported as corrupt, not as a frame waiting for more input
+    std::string bad_size = frame;
+    bad_size[10] ^= 0x40;
+    CHECK(rejected(bad_size));
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+    std::printf("all lz checks passed\n");
+}
@@ -0,0 +1,62 @@
+// checks comparisons between str and the string types it converts to and from
+//
+// build from the repository root:
+//   g++ -std=c++20 -O2 -Isrc tests/str.cpp src/*.cpp -lbacktrace -ldl -pthread -o str_test
+// run:
+//   ./str_test, exits with 1 and says what failed if anything did
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include "AustinUtils.hpp"
+
+using namespace AustinUtils;
+
+static int failures = 0;
+
+#define CHECK(condition) do { if (!(condition)) { std::fprintf(stderr, "%s:%d: %s failed\n", __FILE__, __LINE__, #condition); failures++; } } while (0)
+
+int main() {
+    const str s = "abc";
+
+    //a view into the middle of a longer buffer, so nothing can lean on a null terminator
+    const std::string backing = "xabcdx";
+    const std::string_view same = std::string_view(backing).substr(1, 3);
+    const std::string_view longer = std::string_view(backing).substr(1, 4);
+    const std::string_view prefix = std::string_view(backing).substr(1, 2);
+
+    CHECK(s == same);
+    CHECK(same == s);
+    CHECK(!(s != same));
+    CHECK(!(same != s));
+    CHECK(s != longer);
+    CHECK(longer != s);
+    CHECK(s != prefix);
+
+    CHECK(s < longer);
+    CHECK(longer > s);
+    CHECK(s > prefix);
+    CHECK(prefix < s);
+    CHECK(s <= same);
+    CHECK(same >= s);
+    CHECK(s < std::string_view("abd"));
+    CHECK(std::string_view("abb") < s);
+
+    //the other comparisons keep working next to the string_view ones
+    CHECK(s == "abc");
+    CHECK(s == std::string("abc"));
+    CHECK(s == str("abc"));
+    CHECK(s != "abd");
+
+    //building a str from a view is explicit and copies exactly the viewed chars
+    const str copied(same);
+    CHECK(copied == s);
+    CHECK(copied.len() == 3);
+    CHECK(std::string_view(copied) == "abc");
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+    std::printf("all str checks passed\n");
+}
@@ -0,0 +1,102 @@
+// decodes files written through compressed_sink to stdout, like zcat
+// a frame cut off at the end of a file (a crash while it was written) is reported and skipped,
+// a damaged frame is reported and decoding carries on from the next frame's magic number
+// exits with 1 if anything was skipped
+//
+// build from the repository root:
+//   g++ -std=c++20 -O2 -Isrc tools/lzcat.cpp src/*.cpp -lbacktrace -ldl -pthread -o lzcat
+// run:
+//   ./lzcat app.log.lz [app.log.lz.1 ...], or with no files to read stdin
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include "AustinUtils.hpp"
+
+using namespace AustinUtils;
+
+//where the next frame's magic number starts in data after position from, or data.size()
+static usize findMagic(const std::string_view data, const usize from) {
+    char magic[4];
+    for (usize i = 0; i < 4; i++) magic[i] = cast(LZ_FRAME_MAGIC >> (i*8), char);
+    const usize at = data.find(std::string_view(magic, 4), from);
+    return at == std::string_view::npos ? data.size() : at;
+}
+
+static bool decode(FILE* in, const char* name) {
+    std::string data;
+    std::string out;
+    bool clean = true;
+    char chunk[1 << 16];
+    usize pos = 0;
+    //where data starts in the file, for reporting positions
+    u64 base = 0;
+    bool eof = false;
+
+    while (!eof || pos < data.size()) {
+        if (!eof) {
+            const usize n = std::fread(chunk, 1, sizeof(chunk), in);
+            if (n == 0) eof = true;
+            data.append(chunk, n);
+        }
+
+        while (pos < data.size()) {
+            usize used;
+            try {
+                used = lz_frame_read(std::string_view(data).substr(pos), out);
+            } catch (const Error& e) {
+                //just the message, what() would add the stack trace
+                std::fprintf(stderr, "lzcat: %s: skipping damaged data at byte %llu: %s\n", name, cast(base + pos, unsigned long long),
+                             e.std::runtime_error::what());
+                clean = false;
+                pos = findMagic(data, pos + 1);
+                continue;
+            }
+            if (used == 0) break;
+            pos += used;
+        }
+        if (!out.empty()) {
+            std::fwrite(out.data(), 1, out.size(), stdout);
+            out.clear();
+        }
+
+        if (eof && pos < data.size()) {
+            //a frame that claims to run past the end but has another frame after it was damaged rather than cut off
+            const usize next = findMagic(data, pos + 1);
+            if (next < data.size()) {
+                std::fprintf(stderr, "lzcat: %s: skipping damaged data at byte %llu: the frame runs past the end of the file\n", name,
+                             cast(base + pos, unsigned long long));
+                clean = false;
+                pos = next;
+                continue;
+            }
+            std::fprintf(stderr, "lzcat: %s: the last frame is cut off, %zu bytes skipped\n", name, data.size() - pos);
+            return false;
+        }
+        //keep only the unread tail so memory stays at about one frame
+        data.erase(0, pos);
+        base += pos;
+        pos = 0;
+    }
+    return clean;
+}
+
+int main(const int argc, char** argv) {
+    bool clean = true;
+    if (argc < 2) return decode(stdin, "stdin") ? 0 : 1;
+
+    for (int i = 1; i < argc; i++) {
+        FILE* in = std::fopen(argv[i], "rb");
+        if (in == null) {
+            std::fprintf(stderr, "lzcat: %s: %s\n", argv[i], std::strerror(errno));
+            clean = false;
+            continue;
+        }
+        clean &= decode(in, argv[i]);
+        std::fclose(in);
+    }
+    std::fflush(stdout);
+    return clean ? 0 : 1;
+}